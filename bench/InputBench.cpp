@@ -0,0 +1,257 @@
+#include "MockInputDevice.hpp"
+
+#include <Engine/Core/Hashing/FNV.hpp>
+
+#include <Engine/Input/InputModule.hpp>
+#include <Engine/Input/InputSystem.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Benchmarks of the input hot paths. Every result is printed as one JSON object per line, so runs can be collected
+// and compared across releases:
+//   Rift_Input_bench [--quick] > results.jsonl
+
+using namespace engine;
+using namespace engine::input;
+using namespace engine::input::bench;
+
+using BenchClock = std::chrono::steady_clock;
+
+static bool g_Quick = false;
+
+static double SecondsSince(BenchClock::time_point start) {
+    return std::chrono::duration<double>(BenchClock::now() - start).count();
+}
+
+// keeps the optimizer from throwing away the results of the query loops
+template<typename T>
+static void Consume(T value) {
+    [[maybe_unused]] static volatile T sink;
+    sink = value;
+}
+
+static std::vector<InputEvent> MakeAxisScript(size_t count) {
+    std::vector<InputEvent> script;
+
+    for (size_t i = 0; i < count; ++i) {
+        script.emplace_back(InputEvent::MakeAxisChange(FNVConstHash("Bench_Axis"), static_cast<float>(i)));
+    }
+
+    return script;
+}
+
+// events pushed by 1..N producer threads until they are delivered to a listener by ProcessEvents. producers hold back
+// while the queue is half full, so the result is the sustained end-to-end rate rather than the rate of dropping events.
+static void BenchPushThroughput() {
+    const size_t eventsPerProducer = g_Quick ? 200000 : 2000000;
+    const size_t maxProducers = std::max(1u, std::min(8u, std::thread::hardware_concurrency()));
+    const size_t batchSize = 64;
+    const size_t window = InputEventQueue::DefaultCapacity / 2;
+
+    auto manager = InputManager::Instance();
+
+    for (size_t producerCount = 1; producerCount <= maxProducers; producerCount *= 2) {
+        std::atomic<size_t> pushed{0};
+        std::atomic<size_t> delivered{0};
+        std::atomic<size_t> runningProducers{producerCount};
+
+        auto counter = [&delivered](const InputEvent &) {
+            delivered.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        };
+
+        auto token = manager->AddInputListener(InputEventDelegate::Bind(&counter));
+        manager->ResetLatencyHistograms();
+
+        std::vector<std::thread> producers;
+        auto start = BenchClock::now();
+
+        for (size_t i = 0; i < producerCount; ++i) {
+            producers.emplace_back([&, i] {
+                MockInputDevice device("Bench Producer " + std::to_string(i), MakeAxisScript(batchSize));
+
+                for (size_t count = 0; count < eventsPerProducer; count += batchSize) {
+                    while (pushed.load(std::memory_order_relaxed) - delivered.load(std::memory_order_relaxed) >
+                           window) {
+                        std::this_thread::yield();
+                    }
+
+                    device.Poll();
+                    pushed.fetch_add(batchSize, std::memory_order_relaxed);
+                }
+
+                runningProducers.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        while (runningProducers.load(std::memory_order_acquire) > 0) {
+            manager->ProcessEvents();
+        }
+
+        for (auto &producer: producers) {
+            producer.join();
+        }
+
+        manager->ProcessEvents();
+
+        double seconds = SecondsSince(start);
+        auto latency = manager->GetLatencyHistogram(INPUT_LATENCY_SOURCE_PUSH, INPUT_EVENT_TYPE_AXIS_CHANGE);
+
+        std::printf("{\"suite\":\"push_throughput\",\"producers\":%zu,\"pushed\":%zu,\"delivered\":%zu,"
+                    "\"dropped\":%zu,\"seconds\":%.6f,\"delivered_per_second\":%.0f,\"latency_p50_ns\":%llu,"
+                    "\"latency_p99_ns\":%llu,\"latency_max_ns\":%llu}\n",
+                    producerCount, pushed.load(), delivered.load(), pushed.load() - delivered.load(), seconds,
+                    static_cast<double>(delivered.load()) / seconds,
+                    static_cast<unsigned long long>(latency.GetValueAtPercentile(50.0)),
+                    static_cast<unsigned long long>(latency.GetValueAtPercentile(99.0)),
+                    static_cast<unsigned long long>(latency.Max));
+
+        manager->RemoveInputListener(token);
+    }
+}
+
+// cost of dispatching a full queue against a growing number of listeners
+static void BenchProcessEvents() {
+    const size_t iterations = g_Quick ? 20 : 200;
+    const size_t batchSize = InputEventQueue::DefaultCapacity;
+
+    auto manager = InputManager::Instance();
+    MockInputDevice device("Bench Device", MakeAxisScript(batchSize));
+
+    auto listener = [](const InputEvent &event) {
+        return event.Axis.Value < 0.0f;
+    };
+
+    std::vector<InputListenerToken> tokens;
+
+    for (size_t listenerCount: {0, 1, 4, 16, 64}) {
+        // half of the new listeners aren't interested in axis changes, so they must not add to the cost
+        while (tokens.size() < listenerCount) {
+            auto mask = tokens.size() % 2 == 0 ? InputEventMaskOf(INPUT_EVENT_TYPE_AXIS_CHANGE)
+                                               : InputEventMaskOf(INPUT_EVENT_TYPE_KEY_STATE_CHANGE);
+            tokens.emplace_back(manager->AddInputListener(InputEventDelegate::Bind(&listener), mask));
+        }
+
+        double seconds = 0.0;
+
+        for (size_t i = 0; i < iterations; ++i) {
+            device.Poll();
+
+            auto start = BenchClock::now();
+            manager->ProcessEvents();
+            seconds += SecondsSince(start);
+        }
+
+        size_t events = iterations * batchSize;
+
+        std::printf("{\"suite\":\"process_events\",\"listeners\":%zu,\"interested_listeners\":%zu,\"events\":%zu,"
+                    "\"ns_per_event\":%.2f}\n",
+                    listenerCount, (listenerCount + 1) / 2, events, seconds * 1e9 / static_cast<double>(events));
+    }
+
+    for (auto token: tokens) {
+        manager->RemoveInputListener(token);
+    }
+}
+
+template<typename Query>
+static void BenchQuery(const char *name, Query query) {
+    const size_t iterations = g_Quick ? 1000000 : 50000000;
+
+    auto start = BenchClock::now();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        Consume(query());
+    }
+
+    double seconds = SecondsSince(start);
+
+    std::printf("{\"suite\":\"query\",\"query\":\"%s\",\"iterations\":%zu,\"ns_per_query\":%.3f}\n", name,
+                iterations, seconds * 1e9 / static_cast<double>(iterations));
+}
+
+static void BenchQueries() {
+    auto system = InputSystem::Instance();
+
+    InputBindingSet bindings;
+    bindings.AddAxis(FNVConstHash("BenchAxis"), FNVConstHash("Key_W"), 1.0f);
+    bindings.AddAxis(FNVConstHash("BenchAxis"), FNVConstHash("Key_S"), -1.0f);
+    bindings.AddButton(FNVConstHash("BenchButton"), FNVConstHash("Key_Space"));
+
+    system->SetBindings(std::move(bindings));
+    system->Update();
+
+    auto axisId = system->GetAxisId(FNVConstHash("BenchAxis"));
+    auto buttonId = system->GetButtonId(FNVConstHash("BenchButton"));
+
+    BenchQuery("GetAxis(id)", [&] { return system->GetAxis(axisId); });
+    BenchQuery("GetAxis(handle)", [&] { return system->GetAxis(FNVConstHash("BenchAxis")); });
+    BenchQuery("GetAxis(name)", [&] { return system->GetAxis(std::string_view("BenchAxis")); });
+    BenchQuery("GetButton(id)", [&] { return system->GetButton(buttonId); });
+    BenchQuery("GetButton(handle)", [&] { return system->GetButton(FNVConstHash("BenchButton")); });
+    BenchQuery("GetButton(name)", [&] { return system->GetButton(std::string_view("BenchButton")); });
+
+    system->SetBindings({});
+    system->Update();
+}
+
+// ModuleStartup against a copy of the shipped config; the first run parses it, the following ones use the cache
+static void BenchModuleStartup() {
+    const size_t iterations = g_Quick ? 5 : 50;
+
+    auto workDir = std::filesystem::temp_directory_path() / "Rift_Input_bench";
+    auto configDir = workDir / "Engine" / "Config";
+
+    std::error_code error;
+    std::filesystem::remove_all(workDir, error);
+    std::filesystem::create_directories(configDir, error);
+    std::filesystem::copy_file(RIFT_INPUT_BENCH_CONFIG, configDir / "Input.ini", error);
+
+    if (error) {
+        std::fprintf(stderr, "Failed to set up the module startup benchmark: %s\n", error.message().c_str());
+        return;
+    }
+
+    auto previousDir = std::filesystem::current_path();
+    std::filesystem::current_path(workDir);
+
+    for (size_t i = 0; i < iterations; ++i) {
+        auto start = BenchClock::now();
+        InputModule::ModuleStartup();
+        double seconds = SecondsSince(start);
+
+        InputSystem::Instance()->Shutdown();
+        InputModule::ModuleShutdown();
+
+        std::printf("{\"suite\":\"module_startup\",\"run\":%zu,\"cached\":%s,\"us\":%.2f}\n", i,
+                    i > 0 ? "true" : "false", seconds * 1e6);
+    }
+
+    std::filesystem::current_path(previousDir);
+    std::filesystem::remove_all(workDir, error);
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--quick") {
+            g_Quick = true;
+        }
+    }
+
+    BenchPushThroughput();
+    BenchProcessEvents();
+    BenchQueries();
+    BenchModuleStartup();
+
+    InputManager::Instance()->Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#define SHOW_PRIVATE_API
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Engine/Input/IInputDevice.hpp>
+#include <Engine/Input/InputEvent.hpp>
+#include <Engine/Input/InputManager.hpp>
+
+namespace engine::input::bench {
+    // Device whose every Poll() pushes the same scripted events through the regular Push* API.
+    struct MockInputDevice : IInputDevice {
+        MockInputDevice(std::string name, std::vector<InputEvent> script, int playerId = -1)
+                : m_Name{std::move(name)}, m_Script{std::move(script)}, m_PlayerId{playerId} {}
+
+        bool Initialize() override {
+            return true;
+        }
+
+        void Destroy() override {}
+
+        void Poll() override {
+            auto manager = InputManager::Instance();
+
+            for (auto &event: m_Script) {
+                switch (event.Type) {
+                    case INPUT_EVENT_TYPE_KEY_STATE_CHANGE:
+                        manager->PushKeyStateChange(event.Key.Handle, event.Key.State);
+                        break;
+                    case INPUT_EVENT_TYPE_AXIS_CHANGE:
+                        manager->PushAxisChange(event.Axis.Handle, event.Axis.Value);
+                        break;
+                    case INPUT_EVENT_TYPE_INPUT_CHAR:
+                        manager->PushInputChar(event.Char.Code);
+                        break;
+                    case INPUT_EVENT_TYPE_MOUSE_POSITION:
+                        manager->PushMousePosition(event.Pointer.GetPosition());
+                        break;
+                    case INPUT_EVENT_TYPE_TOUCH_DOWN:
+                        manager->PushTouchDown(event.Pointer.Finger, event.Pointer.GetPosition());
+                        break;
+                    case INPUT_EVENT_TYPE_TOUCH_UP:
+                        manager->PushTouchUp(event.Pointer.Finger, event.Pointer.GetPosition());
+                        break;
+                    case INPUT_EVENT_TYPE_TOUCH_MOVE:
+                        manager->PushTouchMove(event.Pointer.Finger, event.Pointer.GetPosition());
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        std::string GetName() const override {
+            return m_Name;
+        }
+
+        int GetPlayerId() override {
+            return m_PlayerId;
+        }
+
+        size_t GetScriptSize() const {
+            return m_Script.size();
+        }
+
+    protected:
+        std::string m_Name;
+        std::vector<InputEvent> m_Script;
+        int m_PlayerId;
+    };
+}
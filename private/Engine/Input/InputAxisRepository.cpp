@@ -7,18 +7,18 @@ namespace engine::input {
         return g_InputAxisRepository;
     }
 
-    std::string InputAxisRepository::GetAxisName(InputAxisHandle handle) {
-        return m_AxisList.at(handle);
+    std::string_view InputAxisRepository::GetAxisName(InputAxisHandle handle) const {
+        return m_AxisList.Find(handle);
     }
 
-    bool InputAxisRepository::HasAxis(InputAxisHandle handle) {
-        return m_AxisList.contains(handle);
+    bool InputAxisRepository::HasAxis(InputAxisHandle handle) const {
+        return m_AxisList.Contains(handle);
     }
 
     InputAxisHandle InputAxisRepository::AddAxis(std::string_view axis) {
         // hash the axis name for easier identification
         InputAxisHandle handle = engine::FNVConstHash(axis);
-        m_AxisList[handle] = axis;
+        m_AxisList.Add(handle, axis);
         return handle;
     }
 }
\ No newline at end of file
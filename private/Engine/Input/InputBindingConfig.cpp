@@ -0,0 +1,430 @@
+#include <Engine/Input/InputBindingConfig.hpp>
+#include <Engine/Input/InputMappedFile.hpp>
+
+#include <Engine/Core/Hashing/FNV.hpp>
+#include <Engine/Runtime/Logger.hpp>
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+namespace engine::input {
+    static runtime::Logger g_LoggerInputBindingConfig("InputBindingConfig");
+
+    static constexpr std::string_view g_AxisMappingSection = "InputSystem.AxisMapping";
+    static constexpr std::string_view g_ButtonMappingSection = "InputSystem.ButtonMapping";
+    static constexpr std::string_view g_ComboMappingSection = "InputSystem.ComboMapping";
+
+    // The cache is a plain dump of the binding set; it is only ever read back on the machine that wrote it, so
+    // records are stored in native byte order.
+    struct InputBindingCacheHeader {
+        uint32_t Magic;
+        uint32_t Version;
+        // identify the config file the cache was built from
+        uint64_t ConfigSize;
+        int64_t ConfigWriteTime;
+        uint32_t BindingCount;
+        uint32_t AxisSettingsCount;
+        uint32_t ComboCount;
+        // keys of all combos plus one count per step
+        uint32_t ComboWordCount;
+    };
+
+    struct InputBindingCacheBinding {
+        uint32_t Mapping;
+        uint32_t Source;
+        uint32_t Target;
+        float Scale;
+    };
+
+    struct InputBindingCacheAxisSettings {
+        uint32_t Mapping;
+        float DeadZone;
+        float Min;
+        float Max;
+    };
+
+    // followed by its steps in the combo words: the number of keys of each step, then the keys
+    struct InputBindingCacheCombo {
+        uint32_t Mapping;
+        uint32_t StepCount;
+        uint64_t Window;
+    };
+
+    static_assert(sizeof(InputBindingCacheHeader) == 40, "binding cache header layout has changed");
+    static_assert(sizeof(InputBindingCacheBinding) == 16, "binding cache record layout has changed");
+    static_assert(sizeof(InputBindingCacheAxisSettings) == 16, "binding cache record layout has changed");
+    static_assert(sizeof(InputBindingCacheCombo) == 16, "binding cache record layout has changed");
+
+    static std::string_view Trim(std::string_view text) {
+        constexpr std::string_view whitespace = " \t\r\n";
+
+        auto first = text.find_first_not_of(whitespace);
+
+        if (first == std::string_view::npos) {
+            return {};
+        }
+
+        return text.substr(first, text.find_last_not_of(whitespace) - first + 1);
+    }
+
+    // splits "text" at the first "separator"; "text" keeps whatever follows it
+    static std::string_view NextToken(std::string_view &text, char separator) {
+        auto end = text.find(separator);
+        auto token = text.substr(0, end);
+
+        text = end == std::string_view::npos ? std::string_view{} : text.substr(end + 1);
+
+        return Trim(token);
+    }
+
+    static bool GetConfigStamp(const std::filesystem::path &configPath, uint64_t &size, int64_t &writeTime) {
+        std::error_code error;
+
+        size = std::filesystem::file_size(configPath, error);
+
+        if (error) {
+            return false;
+        }
+
+        auto time = std::filesystem::last_write_time(configPath, error);
+
+        if (error) {
+            return false;
+        }
+
+        writeTime = static_cast<int64_t>(time.time_since_epoch().count());
+        return true;
+    }
+
+    size_t InputBindingConfig::Parse(std::string_view text, InputBindingSet &out) {
+        enum { SECTION_NONE, SECTION_AXIS, SECTION_BUTTON, SECTION_COMBO } section = SECTION_NONE;
+
+        size_t bindingCount = 0;
+        size_t lineNumber = 0;
+
+        while (!text.empty()) {
+            auto line = NextToken(text, '\n');
+            ++lineNumber;
+
+            if (line.empty() || line.front() == ';' || line.front() == '#') {
+                continue;
+            }
+
+            if (line.front() == '[') {
+                auto name = Trim(line.substr(1, line.find(']') - 1));
+
+                if (name == g_AxisMappingSection) {
+                    section = SECTION_AXIS;
+                } else if (name == g_ButtonMappingSection) {
+                    section = SECTION_BUTTON;
+                } else if (name == g_ComboMappingSection) {
+                    section = SECTION_COMBO;
+                } else {
+                    section = SECTION_NONE;
+                }
+
+                continue;
+            }
+
+            // entries of sections we don't care about
+            if (section == SECTION_NONE) {
+                continue;
+            }
+
+            auto mapName = NextToken(line, '=');
+
+            if (mapName.empty() || line.empty()) {
+                g_LoggerInputBindingConfig.Log(runtime::LOG_LEVEL_WARNING, "Malformed mapping on line %zu; skipping.",
+                                               lineNumber);
+                continue;
+            }
+
+            InputMapHandle mapping = FNVConstHash(mapName);
+
+            while (!line.empty()) {
+                auto entry = NextToken(line, '|');
+                auto sourceName = NextToken(entry, ',');
+
+                if (sourceName.empty()) {
+                    continue;
+                }
+
+                if (section == SECTION_COMBO) {
+                    std::vector<InputComboStep> steps;
+                    uint32_t window = 0;
+
+                    if (!entry.empty()) {
+                        auto [end, error] = std::from_chars(entry.data(), entry.data() + entry.size(), window);
+
+                        if (error != std::errc() || end != entry.data() + entry.size()) {
+                            g_LoggerInputBindingConfig.Log(runtime::LOG_LEVEL_WARNING,
+                                                           "Invalid combo window on line %zu; skipping combo.",
+                                                           lineNumber);
+                            continue;
+                        }
+                    }
+
+                    if (!ParseComboSteps(sourceName, steps)) {
+                        continue;
+                    }
+
+                    out.AddCombo(mapping, std::move(steps), window * 1000000ull);
+                    ++bindingCount;
+                    continue;
+                }
+
+                if (section == SECTION_BUTTON) {
+                    out.AddButton(mapping, FNVConstHash(sourceName));
+                    ++bindingCount;
+                    continue;
+                }
+
+                float scale = 1.0f;
+
+                if (!entry.empty()) {
+                    auto [end, error] = std::from_chars(entry.data(), entry.data() + entry.size(), scale);
+
+                    if (error != std::errc() || end != entry.data() + entry.size()) {
+                        g_LoggerInputBindingConfig.Log(runtime::LOG_LEVEL_WARNING,
+                                                       "Invalid axis scale on line %zu; skipping binding.", lineNumber);
+                        continue;
+                    }
+                }
+
+                out.AddAxis(mapping, FNVConstHash(sourceName), scale);
+                ++bindingCount;
+            }
+        }
+
+        return bindingCount;
+    }
+
+    bool InputBindingConfig::ParseComboSteps(std::string_view text, std::vector<InputComboStep> &steps) {
+        steps.clear();
+
+        while (!text.empty()) {
+            auto stepText = NextToken(text, ' ');
+
+            // runs of spaces
+            if (stepText.empty()) {
+                continue;
+            }
+
+            InputComboStep step;
+
+            while (!stepText.empty()) {
+                auto keyName = NextToken(stepText, '+');
+
+                if (!keyName.empty()) {
+                    step.push_back(FNVConstHash(keyName));
+                }
+            }
+
+            if (!step.empty()) {
+                steps.push_back(std::move(step));
+            }
+        }
+
+        return !steps.empty();
+    }
+
+    bool InputBindingConfig::Load(const std::filesystem::path &configPath, const std::filesystem::path &cachePath,
+                                  InputBindingSet &out) {
+        if (ReadCache(cachePath, configPath, out)) {
+            g_LoggerInputBindingConfig.Log(runtime::LOG_LEVEL_DEBUG, "Loaded %zu binding(s) from the binding cache.",
+                                           out.Bindings.size());
+            return true;
+        }
+
+        InputMappedFile config;
+
+        if (!config.Open(configPath)) {
+            g_LoggerInputBindingConfig.Log(runtime::LOG_LEVEL_ERROR, "Failed to open input config '%s'!",
+                                           configPath.string().c_str());
+            return false;
+        }
+
+        size_t count = Parse({reinterpret_cast<const char *>(config.GetData()), config.GetSize()}, out);
+        g_LoggerInputBindingConfig.Log(runtime::LOG_LEVEL_DEBUG, "Parsed %zu binding(s) from '%s'.", count,
+                                       configPath.string().c_str());
+
+        if (!WriteCache(cachePath, configPath, out)) {
+            g_LoggerInputBindingConfig.Log(runtime::LOG_LEVEL_WARNING, "Failed to write the binding cache '%s'.",
+                                           cachePath.string().c_str());
+        }
+
+        return true;
+    }
+
+    bool InputBindingConfig::ReadCache(const std::filesystem::path &cachePath, const std::filesystem::path &configPath,
+                                       InputBindingSet &out) {
+        uint64_t configSize;
+        int64_t configWriteTime;
+
+        if (!GetConfigStamp(configPath, configSize, configWriteTime)) {
+            return false;
+        }
+
+        InputMappedFile cache;
+
+        if (!cache.Open(cachePath) || cache.GetSize() < sizeof(InputBindingCacheHeader)) {
+            return false;
+        }
+
+        InputBindingCacheHeader header;
+        std::memcpy(&header, cache.GetData(), sizeof(header));
+
+        if (header.Magic != CacheMagic || header.Version != CacheVersion || header.ConfigSize != configSize ||
+            header.ConfigWriteTime != configWriteTime) {
+            return false;
+        }
+
+        size_t expectedSize = sizeof(header) +
+                              static_cast<size_t>(header.BindingCount) * sizeof(InputBindingCacheBinding) +
+                              static_cast<size_t>(header.AxisSettingsCount) * sizeof(InputBindingCacheAxisSettings) +
+                              static_cast<size_t>(header.ComboCount) * sizeof(InputBindingCacheCombo) +
+                              static_cast<size_t>(header.ComboWordCount) * sizeof(uint32_t);
+
+        if (cache.GetSize() != expectedSize) {
+            return false;
+        }
+
+        // decoded on the side, so that a cache found corrupt halfway leaves "out" as it was for the config parser
+        InputBindingSet set = out;
+        const uint8_t *cursor = cache.GetData() + sizeof(header);
+
+        set.Bindings.reserve(set.Bindings.size() + header.BindingCount);
+
+        for (uint32_t i = 0; i < header.BindingCount; ++i, cursor += sizeof(InputBindingCacheBinding)) {
+            InputBindingCacheBinding record;
+            std::memcpy(&record, cursor, sizeof(record));
+
+            if (record.Target != INPUT_BINDING_TARGET_AXIS && record.Target != INPUT_BINDING_TARGET_BUTTON) {
+                return false;
+            }
+
+            set.Bindings.push_back({record.Mapping, record.Source, static_cast<InputBindingTarget>(record.Target),
+                                    record.Scale});
+        }
+
+        for (uint32_t i = 0; i < header.AxisSettingsCount; ++i, cursor += sizeof(InputBindingCacheAxisSettings)) {
+            InputBindingCacheAxisSettings record;
+            std::memcpy(&record, cursor, sizeof(record));
+
+            set.AxisSettings[record.Mapping] = {record.DeadZone, record.Min, record.Max};
+        }
+
+        const uint8_t *words = cursor + header.ComboCount * sizeof(InputBindingCacheCombo);
+        const uint8_t *wordsEnd = words + header.ComboWordCount * sizeof(uint32_t);
+
+        auto readWord = [&](uint32_t &word) {
+            if (words == wordsEnd) {
+                return false;
+            }
+
+            std::memcpy(&word, words, sizeof(word));
+            words += sizeof(word);
+            return true;
+        };
+
+        for (uint32_t i = 0; i < header.ComboCount; ++i, cursor += sizeof(InputBindingCacheCombo)) {
+            InputBindingCacheCombo record;
+            std::memcpy(&record, cursor, sizeof(record));
+
+            // every step takes at least its key count; checked before the counts size anything
+            if (record.StepCount > static_cast<size_t>(wordsEnd - words) / sizeof(uint32_t)) {
+                return false;
+            }
+
+            std::vector<InputComboStep> steps(record.StepCount);
+
+            for (auto &step: steps) {
+                uint32_t keyCount;
+
+                if (!readWord(keyCount) || keyCount > static_cast<size_t>(wordsEnd - words) / sizeof(uint32_t)) {
+                    return false;
+                }
+
+                step.resize(keyCount);
+
+                for (auto &key: step) {
+                    if (!readWord(key)) {
+                        return false;
+                    }
+                }
+            }
+
+            set.AddCombo(record.Mapping, std::move(steps), record.Window);
+        }
+
+        out = std::move(set);
+        return true;
+    }
+
+    bool InputBindingConfig::WriteCache(const std::filesystem::path &cachePath, const std::filesystem::path &configPath,
+                                        const InputBindingSet &set) {
+        uint32_t comboWordCount = 0;
+
+        for (auto &combo: set.Combos) {
+            for (auto &step: combo.Steps) {
+                comboWordCount += 1 + static_cast<uint32_t>(step.size());
+            }
+        }
+
+        InputBindingCacheHeader header{CacheMagic, CacheVersion, 0, 0, static_cast<uint32_t>(set.Bindings.size()),
+                                       static_cast<uint32_t>(set.AxisSettings.size()),
+                                       static_cast<uint32_t>(set.Combos.size()), comboWordCount};
+
+        if (!GetConfigStamp(configPath, header.ConfigSize, header.ConfigWriteTime)) {
+            return false;
+        }
+
+        // write to a temporary file first, so that a concurrent reader never maps a half written cache
+        auto tempPath = cachePath;
+        tempPath += ".tmp";
+
+        {
+            std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+
+            if (!stream) {
+                return false;
+            }
+
+            stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+            for (auto &binding: set.Bindings) {
+                InputBindingCacheBinding record{binding.Mapping, binding.Source, binding.Target, binding.Scale};
+                stream.write(reinterpret_cast<const char *>(&record), sizeof(record));
+            }
+
+            for (auto &[mapping, settings]: set.AxisSettings) {
+                InputBindingCacheAxisSettings record{mapping, settings.DeadZone, settings.Min, settings.Max};
+                stream.write(reinterpret_cast<const char *>(&record), sizeof(record));
+            }
+
+            for (auto &combo: set.Combos) {
+                InputBindingCacheCombo record{combo.Mapping, static_cast<uint32_t>(combo.Steps.size()), combo.Window};
+                stream.write(reinterpret_cast<const char *>(&record), sizeof(record));
+            }
+
+            for (auto &combo: set.Combos) {
+                for (auto &step: combo.Steps) {
+                    auto keyCount = static_cast<uint32_t>(step.size());
+                    stream.write(reinterpret_cast<const char *>(&keyCount), sizeof(keyCount));
+                    stream.write(reinterpret_cast<const char *>(step.data()), keyCount * sizeof(InputKeyHandle));
+                }
+            }
+
+            if (!stream) {
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, cachePath, error);
+
+        return !error;
+    }
+}
@@ -0,0 +1,126 @@
+#include <Engine/Input/InputBindingTable.hpp>
+
+namespace engine::input {
+    void InputBindingSet::AddAxis(InputMapHandle mapping, uint32_t source, float scale) {
+        for (auto &binding: Bindings) {
+            if (binding.Mapping == mapping && binding.Source == source && binding.Target == INPUT_BINDING_TARGET_AXIS) {
+                binding.Scale = scale;
+                return;
+            }
+        }
+
+        Bindings.push_back({mapping, source, INPUT_BINDING_TARGET_AXIS, scale});
+    }
+
+    void InputBindingSet::AddButton(InputMapHandle mapping, uint32_t source) {
+        for (auto &binding: Bindings) {
+            if (binding.Mapping == mapping && binding.Source == source && binding.Target == INPUT_BINDING_TARGET_BUTTON) {
+                return;
+            }
+        }
+
+        Bindings.push_back({mapping, source, INPUT_BINDING_TARGET_BUTTON, 1.0f});
+    }
+
+    bool InputBindingSet::Remove(InputMapHandle mapping, uint32_t source, InputBindingTarget target) {
+        auto it = std::find_if(Bindings.begin(), Bindings.end(), [&](const InputBindingDesc &binding) {
+            return binding.Mapping == mapping && binding.Source == source && binding.Target == target;
+        });
+
+        if (it == Bindings.end()) {
+            return false;
+        }
+
+        Bindings.erase(it);
+        return true;
+    }
+
+    void InputBindingSet::SetAxisSettings(InputMapHandle mapping, const InputAxisSettings &settings) {
+        AxisSettings[mapping] = settings;
+    }
+
+    void InputBindingSet::AddCombo(InputMapHandle mapping, std::vector<InputComboStep> steps, uint64_t window) {
+        for (auto &combo: Combos) {
+            if (combo.Mapping == mapping && combo.Steps == steps) {
+                combo.Window = window;
+                return;
+            }
+        }
+
+        Combos.push_back({mapping, std::move(steps), window});
+    }
+
+    bool InputBindingSet::RemoveCombos(InputMapHandle mapping) {
+        return std::erase_if(Combos, [&](const InputComboDesc &combo) {
+            return combo.Mapping == mapping;
+        }) > 0;
+    }
+
+    std::shared_ptr<const InputBindingTable> InputBindingSet::Compile(const InputBindingTable *previous) const {
+        auto table = std::make_shared<InputBindingTable>();
+
+        // keep the ids handed out so far; mappings are never given a different id
+        if (previous) {
+            table->AxisIds = previous->AxisIds;
+            table->ButtonIds = previous->ButtonIds;
+            table->AxisSettings.resize(previous->AxisSettings.size());
+            table->ButtonCount = previous->ButtonCount;
+            table->ComboIds = previous->ComboIds;
+            table->ComboCount = previous->ComboCount;
+        }
+
+        for (auto &binding: Bindings) {
+            if (binding.Target == INPUT_BINDING_TARGET_AXIS) {
+                if (table->AxisIds.try_emplace(binding.Mapping, InputAxisId{table->GetAxisCount()}).second) {
+                    table->AxisSettings.emplace_back();
+                }
+            } else {
+                if (table->ButtonIds.try_emplace(binding.Mapping, InputButtonId{table->ButtonCount}).second) {
+                    ++table->ButtonCount;
+                }
+            }
+        }
+
+        for (auto &[mapping, id]: table->AxisIds) {
+            auto settings = AxisSettings.find(mapping);
+            table->AxisSettings[id.Index] = settings != AxisSettings.end() ? settings->second : InputAxisSettings{};
+        }
+
+        // group the bindings by source, so that an event only touches the bindings of its own source
+        auto bindings = Bindings;
+
+        std::stable_sort(bindings.begin(), bindings.end(), [](const InputBindingDesc &a, const InputBindingDesc &b) {
+            return a.Source < b.Source;
+        });
+
+        table->Bindings.reserve(bindings.size());
+
+        for (auto &binding: bindings) {
+            if (table->Sources.empty() || table->Sources.back().Handle != binding.Source) {
+                table->SourceIndices[binding.Source] = static_cast<uint32_t>(table->Sources.size());
+                table->Sources.push_back({binding.Source, static_cast<uint32_t>(table->Bindings.size()), 0});
+            }
+
+            uint32_t mapIndex = binding.Target == INPUT_BINDING_TARGET_AXIS ? table->AxisIds[binding.Mapping].Index
+                                                                            : table->ButtonIds[binding.Mapping].Index;
+
+            table->Bindings.push_back({mapIndex, binding.Target, binding.Scale});
+            ++table->Sources.back().BindingCount;
+        }
+
+        std::vector<InputComboMatcher::Pattern> combos;
+        combos.reserve(Combos.size());
+
+        for (auto &combo: Combos) {
+            if (table->ComboIds.try_emplace(combo.Mapping, InputComboId{table->ComboCount}).second) {
+                ++table->ComboCount;
+            }
+
+            combos.push_back({table->ComboIds[combo.Mapping].Index, combo.Steps, combo.Window});
+        }
+
+        table->ComboMatcher = InputComboMatcher::Compile(combos);
+
+        return table;
+    }
+}
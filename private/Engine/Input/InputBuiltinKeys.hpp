@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+#include <Engine/Core/Hashing/FNV.hpp>
+
+#include <Engine/Input/InputKeyRepository.hpp>
+
+namespace engine::input {
+    // Keys known on every platform. They are resolved at compile time; only platform specific keys (e.g. the
+    // NX_JoyCon_* ones) go through InputKeyRepository::AddKey at runtime.
+    inline constexpr std::string_view g_BuiltinKeyNames[] = {
+            // mouse keys
+            "Mouse_Left", "Mouse_Right", "Mouse_Middle",
+
+            // keyboard keys (letters)
+            "Key_A", "Key_B", "Key_C", "Key_D", "Key_E", "Key_F", "Key_G", "Key_H", "Key_I", "Key_J", "Key_K", "Key_L",
+            "Key_M", "Key_N", "Key_O", "Key_P", "Key_Q", "Key_R", "Key_S", "Key_T", "Key_U", "Key_V", "Key_W", "Key_X",
+            "Key_Y", "Key_Z",
+
+            // keyboard keys (numbers)
+            "Key_0", "Key_1", "Key_2", "Key_3", "Key_4", "Key_5", "Key_6", "Key_7", "Key_8", "Key_9",
+
+            // function keys
+            "Key_F1", "Key_F2", "Key_F3", "Key_F4", "Key_F5", "Key_F6", "Key_F7", "Key_F8", "Key_F9", "Key_F10",
+            "Key_F11", "Key_F12", "Key_F13", "Key_F14", "Key_F15", "Key_F16", "Key_F17", "Key_F18", "Key_F19",
+            "Key_F20", "Key_F21", "Key_F22", "Key_F23", "Key_F24",
+
+            // modifier keys
+            "Key_LeftCtrl", "Key_LeftShift", "Key_LeftAlt", "Key_LeftSuper", "Key_RightCtrl", "Key_RightShift",
+            "Key_RightAlt", "Key_RightSuper", "Key_Menu",
+
+            // punctuation and symbol keys
+            "Key_Apostrophe", "Key_Comma", "Key_Minus", "Key_Period", "Key_Slash", "Key_Semicolon", "Key_Equal",
+            "Key_LeftBracket", "Key_Backslash", "Key_RightBracket", "Key_GraveAccent",
+
+            // system and lock keys
+            "Key_CapsLock", "Key_ScrollLock", "Key_NumLock", "Key_PrintScreen", "Key_Pause",
+
+            // navigation keys
+            "Key_Insert", "Key_Delete", "Key_Home", "Key_End", "Key_PageUp", "Key_PageDown",
+
+            // arrow keys
+            "Key_ArrowUp", "Key_ArrowDown", "Key_ArrowLeft", "Key_ArrowRight",
+
+            // keypad (numpad) keys
+            "Key_Keypad0", "Key_Keypad1", "Key_Keypad2", "Key_Keypad3", "Key_Keypad4", "Key_Keypad5", "Key_Keypad6",
+            "Key_Keypad7", "Key_Keypad8", "Key_Keypad9", "Key_KeypadDecimal", "Key_KeypadDivide", "Key_KeypadMultiply",
+            "Key_KeypadSubtract", "Key_KeypadAdd", "Key_KeypadEnter", "Key_KeypadEqual",
+
+            // special keys
+            "Key_Space", "Key_Enter", "Key_Escape", "Key_Backspace", "Key_Tab"
+    };
+
+    inline constexpr size_t BuiltinKeyCount = std::size(g_BuiltinKeyNames);
+
+    // Perfect hash over the handles of the built-in keys, generated at compile time with hash-and-displace: the low
+    // bits of a handle select a bucket, and every bucket stores the displacement that sends all of its handles to
+    // distinct free slots.
+    struct InputBuiltinKeyTable {
+        static constexpr size_t SlotCount = 256;
+        static constexpr size_t BucketCount = 64;
+        static constexpr size_t MaxBucketSize = 16;
+        static constexpr uint16_t EmptySlot = UINT16_MAX;
+
+        static_assert(SlotCount >= BuiltinKeyCount && SlotCount < EmptySlot, "the built-in key table is too small");
+
+        std::array<InputKeyHandle, SlotCount> Handles{};
+        // index into g_BuiltinKeyNames, or EmptySlot
+        std::array<uint16_t, SlotCount> NameIndices{};
+        std::array<uint16_t, BucketCount> Displacements{};
+        bool IsValid{false};
+
+        static constexpr uint32_t GetSlot(InputKeyHandle handle, uint16_t displacement) {
+            uint32_t x = (handle ^ (displacement * 0x9E3779B9u)) * 0x85EBCA6Bu;
+            return (x ^ (x >> 16)) & (SlotCount - 1);
+        }
+
+        constexpr uint32_t GetSlot(InputKeyHandle handle) const {
+            return GetSlot(handle, Displacements[handle & (BucketCount - 1)]);
+        }
+
+        // branch-free: a single probe of the slot the handle maps to
+        constexpr bool Contains(InputKeyHandle handle) const {
+            uint32_t slot = GetSlot(handle);
+            return (Handles[slot] == handle) & (NameIndices[slot] != EmptySlot);
+        }
+
+        // returns an empty view if the handle isn't a built-in key
+        constexpr std::string_view GetName(InputKeyHandle handle) const {
+            return Contains(handle) ? g_BuiltinKeyNames[NameIndices[GetSlot(handle)]] : std::string_view{};
+        }
+    };
+
+    constexpr bool HasUniqueBuiltinKeyHandles() {
+        for (size_t i = 0; i < BuiltinKeyCount; ++i) {
+            for (size_t j = i + 1; j < BuiltinKeyCount; ++j) {
+                if (FNVConstHash(g_BuiltinKeyNames[i]) == FNVConstHash(g_BuiltinKeyNames[j])) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    constexpr InputBuiltinKeyTable BuildBuiltinKeyTable() {
+        using Table = InputBuiltinKeyTable;
+
+        Table table{};
+        table.NameIndices.fill(Table::EmptySlot);
+
+        std::array<size_t, Table::BucketCount> bucketSizes{};
+        std::array<size_t, Table::BucketCount> bucketOrder{};
+
+        for (size_t i = 0; i < BuiltinKeyCount; ++i) {
+            ++bucketSizes[FNVConstHash(g_BuiltinKeyNames[i]) & (Table::BucketCount - 1)];
+        }
+
+        // place the largest buckets first, while there's still plenty of room
+        for (size_t i = 0; i < Table::BucketCount; ++i) {
+            bucketOrder[i] = i;
+        }
+
+        std::sort(bucketOrder.begin(), bucketOrder.end(), [&bucketSizes](size_t a, size_t b) {
+            return bucketSizes[a] > bucketSizes[b];
+        });
+
+        for (auto bucket: bucketOrder) {
+            std::array<size_t, Table::MaxBucketSize> members{};
+            size_t memberCount = 0;
+
+            for (size_t i = 0; i < BuiltinKeyCount; ++i) {
+                if ((FNVConstHash(g_BuiltinKeyNames[i]) & (Table::BucketCount - 1)) != bucket) {
+                    continue;
+                }
+
+                if (memberCount == Table::MaxBucketSize) {
+                    return table;
+                }
+
+                members[memberCount++] = i;
+            }
+
+            if (memberCount == 0) {
+                continue;
+            }
+
+            bool isPlaced = false;
+
+            for (uint32_t displacement = 0; displacement < UINT16_MAX && !isPlaced; ++displacement) {
+                std::array<uint32_t, Table::MaxBucketSize> slots{};
+                isPlaced = true;
+
+                for (size_t m = 0; m < memberCount && isPlaced; ++m) {
+                    slots[m] = Table::GetSlot(FNVConstHash(g_BuiltinKeyNames[members[m]]),
+                                              static_cast<uint16_t>(displacement));
+
+                    // the slot must be free and not taken by another member of the same bucket
+                    isPlaced = table.NameIndices[slots[m]] == Table::EmptySlot &&
+                               std::find(slots.begin(), slots.begin() + m, slots[m]) == slots.begin() + m;
+                }
+
+                if (isPlaced) {
+                    table.Displacements[bucket] = static_cast<uint16_t>(displacement);
+
+                    for (size_t m = 0; m < memberCount; ++m) {
+                        table.Handles[slots[m]] = FNVConstHash(g_BuiltinKeyNames[members[m]]);
+                        table.NameIndices[slots[m]] = static_cast<uint16_t>(members[m]);
+                    }
+                }
+            }
+
+            if (!isPlaced) {
+                return table;
+            }
+        }
+
+        table.IsValid = true;
+        return table;
+    }
+
+    inline constexpr InputBuiltinKeyTable g_BuiltinKeyTable = BuildBuiltinKeyTable();
+
+    static_assert(HasUniqueBuiltinKeyHandles(), "two built-in key names share the same FNV hash");
+    static_assert(g_BuiltinKeyTable.IsValid, "failed to generate the built-in key perfect hash");
+}
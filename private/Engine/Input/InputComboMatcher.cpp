@@ -0,0 +1,276 @@
+#include <Engine/Input/InputComboMatcher.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <map>
+
+namespace engine::input {
+    static runtime::Logger g_LoggerInputComboMatcher("InputComboMatcher");
+
+    static constexpr uint32_t g_NoState = UINT32_MAX;
+
+    InputComboMatcher InputComboMatcher::Compile(const std::vector<Pattern> &patterns) {
+        InputComboMatcher matcher;
+
+        // every distinct set of keys becomes one symbol, shared by all the combos using it
+        std::map<KeyMask, uint32_t> stepIndices;
+        std::vector<std::vector<uint32_t>> sequences(patterns.size());
+
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            auto &pattern = patterns[i];
+
+            // check the key budget first, so that a rejected combo doesn't leave keys behind
+            std::vector<InputKeyHandle> newKeys;
+            bool isValid = !pattern.Steps.empty();
+
+            for (auto &step: pattern.Steps) {
+                isValid = isValid && !step.empty();
+
+                for (auto key: step) {
+                    if (matcher.m_KeyIndices.find(key) == matcher.m_KeyIndices.end() &&
+                        std::find(newKeys.begin(), newKeys.end(), key) == newKeys.end()) {
+                        newKeys.push_back(key);
+                    }
+                }
+            }
+
+            if (!isValid) {
+                g_LoggerInputComboMatcher.Log(runtime::LOG_LEVEL_WARNING, "Combo %u has an empty step; skipping.",
+                                              pattern.Id);
+                continue;
+            }
+
+            if (matcher.m_Keys.size() + newKeys.size() > MaxKeys) {
+                g_LoggerInputComboMatcher.Log(runtime::LOG_LEVEL_WARNING,
+                                              "Combo %u exceeds the limit of %zu combo keys; skipping.", pattern.Id,
+                                              MaxKeys);
+                continue;
+            }
+
+            for (auto key: newKeys) {
+                matcher.m_KeyIndices[key] = static_cast<uint32_t>(matcher.m_Keys.size());
+                matcher.m_Keys.push_back(key);
+            }
+
+            for (auto &step: pattern.Steps) {
+                KeyMask keys{};
+
+                for (auto key: step) {
+                    uint32_t bit = matcher.m_KeyIndices[key];
+                    keys[bit >> 6] |= uint64_t{1} << (bit & 63);
+                }
+
+                auto [it, inserted] = stepIndices.try_emplace(keys, static_cast<uint32_t>(matcher.m_Steps.size()));
+
+                if (inserted) {
+                    uint32_t keyCount = 0;
+
+                    for (auto word: keys) {
+                        keyCount += std::popcount(word);
+                    }
+
+                    matcher.m_Steps.push_back({keys, keyCount});
+                }
+
+                sequences[i].push_back(it->second);
+            }
+        }
+
+        // steps by key, most specific first: a press is read as the largest chord it completes
+        std::vector<std::vector<uint32_t>> keySteps(matcher.m_Keys.size());
+
+        for (uint32_t step = 0; step < matcher.m_Steps.size(); ++step) {
+            for (uint32_t bit = 0; bit < matcher.m_Keys.size(); ++bit) {
+                if ((matcher.m_Steps[step].Keys[bit >> 6] >> (bit & 63)) & 1) {
+                    keySteps[bit].push_back(step);
+                }
+            }
+        }
+
+        matcher.m_KeyStepStarts.assign(1, 0);
+
+        for (auto &steps: keySteps) {
+            std::stable_sort(steps.begin(), steps.end(), [&](uint32_t a, uint32_t b) {
+                return matcher.m_Steps[a].KeyCount > matcher.m_Steps[b].KeyCount;
+            });
+
+            matcher.m_KeySteps.insert(matcher.m_KeySteps.end(), steps.begin(), steps.end());
+            matcher.m_KeyStepStarts.push_back(static_cast<uint32_t>(matcher.m_KeySteps.size()));
+        }
+
+        // trie of the step sequences
+        size_t symbolCount = matcher.m_Steps.size();
+        auto &transitions = matcher.m_Transitions;
+        std::vector<std::vector<Output>> outputs(1);
+
+        transitions.assign(symbolCount, g_NoState);
+
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            if (sequences[i].empty()) {
+                continue;
+            }
+
+            uint32_t node = 0;
+
+            for (auto symbol: sequences[i]) {
+                size_t edge = node * symbolCount + symbol;
+
+                if (transitions[edge] == g_NoState) {
+                    transitions[edge] = static_cast<uint32_t>(outputs.size());
+                    transitions.resize(transitions.size() + symbolCount, g_NoState);
+                    outputs.emplace_back();
+                }
+
+                node = transitions[edge];
+            }
+
+            auto length = static_cast<uint32_t>(sequences[i].size());
+            outputs[node].push_back({patterns[i].Id, length, patterns[i].Window});
+            matcher.m_MaxLength = std::max(matcher.m_MaxLength, length);
+        }
+
+        // Aho-Corasick, breadth first: missing edges are redirected to where the failure state would go, which turns
+        // the trie into a complete DFA. a state also completes every combo its failure state completes.
+        std::vector<uint32_t> failures(outputs.size(), 0);
+        std::vector<uint32_t> queue;
+
+        for (size_t symbol = 0; symbol < symbolCount; ++symbol) {
+            if (transitions[symbol] == g_NoState) {
+                transitions[symbol] = 0;
+            } else {
+                queue.push_back(transitions[symbol]);
+            }
+        }
+
+        for (size_t i = 0; i < queue.size(); ++i) {
+            uint32_t node = queue[i];
+            uint32_t failure = failures[node];
+
+            // shallower, so its outputs are complete already
+            outputs[node].insert(outputs[node].end(), outputs[failure].begin(), outputs[failure].end());
+
+            for (size_t symbol = 0; symbol < symbolCount; ++symbol) {
+                uint32_t &next = transitions[node * symbolCount + symbol];
+                uint32_t failureNext = transitions[failure * symbolCount + symbol];
+
+                if (next == g_NoState) {
+                    next = failureNext;
+                } else {
+                    failures[next] = failureNext;
+                    queue.push_back(next);
+                }
+            }
+        }
+
+        matcher.m_OutputStarts.assign(1, 0);
+
+        for (auto &nodeOutputs: outputs) {
+            matcher.m_Outputs.insert(matcher.m_Outputs.end(), nodeOutputs.begin(), nodeOutputs.end());
+            matcher.m_OutputStarts.push_back(static_cast<uint32_t>(matcher.m_Outputs.size()));
+        }
+
+        return matcher;
+    }
+
+    void InputComboMatcher::Reset(State &state) const {
+        state.Node = 0;
+        state.Held = {};
+        state.Pending = {};
+        state.StepTimes.assign(std::bit_ceil(std::max<size_t>(m_MaxLength, 1)), 0);
+        state.StepCount = 0;
+    }
+
+    void InputComboMatcher::SetHeld(State &state, InputKeyHandle key) const {
+        auto it = m_KeyIndices.find(key);
+
+        if (it != m_KeyIndices.end()) {
+            state.Held[it->second >> 6] |= uint64_t{1} << (it->second & 63);
+        }
+    }
+
+    void InputComboMatcher::Advance(State &state, InputKeyHandle key, bool pressed, uint64_t timestamp,
+                                    std::vector<uint32_t> &matched) const {
+        auto it = m_KeyIndices.find(key);
+
+        if (it == m_KeyIndices.end()) {
+            return;
+        }
+
+        uint32_t bit = it->second;
+        uint64_t mask = uint64_t{1} << (bit & 63);
+        bool wasHeld = (state.Held[bit >> 6] & mask) != 0;
+
+        if (!pressed) {
+            state.Held[bit >> 6] &= ~mask;
+
+            // a chord let go of before it completed counts as a wrong press
+            if (state.Pending[bit >> 6] & mask) {
+                state.Node = 0;
+                state.Pending = {};
+            }
+
+            return;
+        }
+
+        // a repeated press of a held key doesn't complete anything new
+        if (wasHeld) {
+            return;
+        }
+
+        state.Held[bit >> 6] |= mask;
+        state.Pending[bit >> 6] |= mask;
+
+        // of the held steps, the one made of the chord being put together wins over keys held from before
+        uint32_t symbol = g_NoState;
+
+        for (uint32_t i = m_KeyStepStarts[bit]; i < m_KeyStepStarts[bit + 1]; ++i) {
+            auto &keys = m_Steps[m_KeySteps[i]].Keys;
+
+            if (!Contains(state.Held, keys)) {
+                continue;
+            }
+
+            if (Contains(keys, state.Pending)) {
+                symbol = m_KeySteps[i];
+                break;
+            }
+
+            if (symbol == g_NoState) {
+                symbol = m_KeySteps[i];
+            }
+        }
+
+        if (symbol == g_NoState) {
+            // the first keys of a chord complete nothing yet; only a chord no step can be made of anymore breaks the
+            // sequences in progress
+            for (uint32_t i = m_KeyStepStarts[bit]; i < m_KeyStepStarts[bit + 1]; ++i) {
+                if (Contains(m_Steps[m_KeySteps[i]].Keys, state.Pending)) {
+                    return;
+                }
+            }
+
+            state.Node = 0;
+            state.Pending = {};
+            state.Pending[bit >> 6] = mask;
+            return;
+        }
+
+        state.Pending = {};
+
+        size_t ringMask = state.StepTimes.size() - 1;
+
+        state.Node = m_Transitions[state.Node * m_Steps.size() + symbol];
+        state.StepTimes[state.StepCount++ & ringMask] = timestamp;
+
+        for (uint32_t i = m_OutputStarts[state.Node]; i < m_OutputStarts[state.Node + 1]; ++i) {
+            auto &output = m_Outputs[i];
+            uint64_t firstStep = state.StepTimes[(state.StepCount - output.Length) & ringMask];
+
+            if (output.Window == 0 || timestamp - firstStep <= output.Window) {
+                matched.push_back(output.Id);
+            }
+        }
+    }
+}
@@ -0,0 +1,142 @@
+#include <Engine/Input/InputDeviceWaiter.hpp>
+
+#include <thread>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cstdint>
+#endif
+
+namespace engine::input {
+#ifdef __linux__
+    // upper bound of events fetched by a single epoll_wait call
+    static constexpr int MaxEpollEvents = 32;
+
+    InputDeviceWaiter::InputDeviceWaiter() {
+        m_EpollFd = epoll_create1(EPOLL_CLOEXEC);
+        m_WakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+        if (m_EpollFd >= 0 && m_WakeFd >= 0) {
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.fd = m_WakeFd;
+
+            epoll_ctl(m_EpollFd, EPOLL_CTL_ADD, m_WakeFd, &ev);
+        }
+    }
+
+    InputDeviceWaiter::~InputDeviceWaiter() {
+        if (m_WakeFd >= 0) {
+            close(m_WakeFd);
+        }
+
+        if (m_EpollFd >= 0) {
+            close(m_EpollFd);
+        }
+    }
+
+    bool InputDeviceWaiter::CanWatchHandles() const {
+        return m_EpollFd >= 0 && m_WakeFd >= 0;
+    }
+
+    bool InputDeviceWaiter::Watch(InputWaitHandle handle) {
+        if (!CanWatchHandles() || handle == INPUT_WAIT_HANDLE_INVALID) {
+            return false;
+        }
+
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = handle;
+
+        return epoll_ctl(m_EpollFd, EPOLL_CTL_ADD, handle, &ev) == 0;
+    }
+
+    void InputDeviceWaiter::Unwatch(InputWaitHandle handle) {
+        if (CanWatchHandles() && handle != INPUT_WAIT_HANDLE_INVALID) {
+            epoll_ctl(m_EpollFd, EPOLL_CTL_DEL, handle, nullptr);
+        }
+    }
+
+    size_t InputDeviceWaiter::Wait(std::chrono::microseconds timeout, InputWaitHandle *ready, size_t maxReady) {
+        // round up so that sub-millisecond timeouts don't degrade into a busy loop
+        int timeoutMs = timeout.count() < 0 ? -1 : static_cast<int>((timeout.count() + 999) / 1000);
+
+        if (!CanWatchHandles()) {
+            // nothing to block on; degrade to a plain sleep so that the caller keeps its cadence
+            std::this_thread::sleep_for(timeout.count() < 0 ? std::chrono::milliseconds(1) : timeout);
+            return 0;
+        }
+
+        epoll_event events[MaxEpollEvents];
+        int count = epoll_wait(m_EpollFd, events, MaxEpollEvents, timeoutMs);
+        size_t readyCount = 0;
+
+        for (int i = 0; i < count; ++i) {
+            if (events[i].data.fd == m_WakeFd) {
+                uint64_t value;
+
+                // reset the wake counter; the value itself doesn't matter
+                while (read(m_WakeFd, &value, sizeof(value)) > 0) {}
+                continue;
+            }
+
+            // epoll keeps reporting a hung up handle for as long as it's watched, which would spin the caller; stop
+            // watching it and report it one last time, so that its device reads whatever is left and notices the loss
+            if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                epoll_ctl(m_EpollFd, EPOLL_CTL_DEL, events[i].data.fd, nullptr);
+            }
+
+            if (readyCount < maxReady) {
+                ready[readyCount++] = events[i].data.fd;
+            }
+        }
+
+        return readyCount;
+    }
+
+    void InputDeviceWaiter::Wake() {
+        if (m_WakeFd >= 0) {
+            uint64_t value = 1;
+            [[maybe_unused]] auto written = write(m_WakeFd, &value, sizeof(value));
+        }
+    }
+#else
+    InputDeviceWaiter::InputDeviceWaiter() : b_WakeRequested{false} {}
+
+    InputDeviceWaiter::~InputDeviceWaiter() = default;
+
+    bool InputDeviceWaiter::CanWatchHandles() const {
+        return false;
+    }
+
+    bool InputDeviceWaiter::Watch(InputWaitHandle handle) {
+        return false;
+    }
+
+    void InputDeviceWaiter::Unwatch(InputWaitHandle handle) {}
+
+    size_t InputDeviceWaiter::Wait(std::chrono::microseconds timeout, InputWaitHandle *ready, size_t maxReady) {
+        std::unique_lock<std::mutex> lock(m_WakeMutex);
+
+        if (timeout.count() < 0) {
+            m_WakeCondition.wait(lock, [this] { return b_WakeRequested; });
+        } else {
+            m_WakeCondition.wait_for(lock, timeout, [this] { return b_WakeRequested; });
+        }
+
+        b_WakeRequested = false;
+        return 0;
+    }
+
+    void InputDeviceWaiter::Wake() {
+        {
+            std::lock_guard<std::mutex> lock(m_WakeMutex);
+            b_WakeRequested = true;
+        }
+
+        m_WakeCondition.notify_one();
+    }
+#endif
+}
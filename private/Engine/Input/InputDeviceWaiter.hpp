@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+#include <Engine/Input/IInputDevice.hpp>
+
+namespace engine::input {
+    // Blocks the input thread until a watched device handle becomes readable, Wake() is called or a timeout expires.
+    // Uses epoll on Linux; on the other platforms handles can't be watched and Wait() simply sleeps until woken up or
+    // timed out, so every device falls back to fixed-rate polling.
+    struct InputDeviceWaiter {
+        InputDeviceWaiter();
+
+        ~InputDeviceWaiter();
+
+        InputDeviceWaiter(const InputDeviceWaiter &) = delete;
+
+        InputDeviceWaiter &operator=(const InputDeviceWaiter &) = delete;
+
+        // whether handles can be watched on this platform
+        bool CanWatchHandles() const;
+
+        bool Watch(InputWaitHandle handle);
+
+        void Unwatch(InputWaitHandle handle);
+
+        // a negative timeout waits indefinitely. writes at most "maxReady" readable handles to "ready" and returns
+        // their count; 0 means the wait timed out or was woken up. handles that hung up or failed are reported once
+        // and then no longer watched; Unwatch is still safe to call on them.
+        size_t Wait(std::chrono::microseconds timeout, InputWaitHandle *ready, size_t maxReady);
+
+        // interrupts a pending (or the next) Wait call; safe to call from any thread.
+        void Wake();
+
+    protected:
+#ifdef __linux__
+        int m_EpollFd;
+        int m_WakeFd;
+#else
+        std::mutex m_WakeMutex;
+        std::condition_variable m_WakeCondition;
+        bool b_WakeRequested;
+#endif
+    };
+}
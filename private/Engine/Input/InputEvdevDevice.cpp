@@ -0,0 +1,477 @@
+#define SHOW_PRIVATE_API
+
+#include <Engine/Input/InputEvdevDevice.hpp>
+#include <Engine/Input/InputManager.hpp>
+#include <Engine/Input/InputBuiltinKeys.hpp>
+
+#include <Engine/Core/Hashing/FNV.hpp>
+#include <Engine/Runtime/Logger.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <string_view>
+
+#ifdef __linux__
+#include <linux/input.h>
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <ctime>
+#endif
+
+namespace engine::input {
+    static runtime::Logger g_LoggerInputEvdevDevice("InputEvdevDevice");
+
+#ifdef __linux__
+    static_assert(KEY_CNT <= 12 * 64, "InputEvdevDevice::m_KeyBits can't hold every key code");
+    static_assert(ABS_CNT <= 64 && REL_CNT <= 32, "InputEvdevDevice can't track every axis code");
+
+    struct EvdevKeyName {
+        uint16_t Code;
+        std::string_view Name;
+    };
+
+    enum EvdevAxisFlags : uint8_t {
+        EVDEV_AXIS_FLAG_NONE = 0,
+        // normalized to [0, 1] rather than [-1, 1]
+        EVDEV_AXIS_FLAG_UNIPOLAR = 1 << 0,
+        // evdev reports down as positive; flipped so that up is positive like on every other backend
+        EVDEV_AXIS_FLAG_INVERTED = 1 << 1
+    };
+
+    struct EvdevAxisName {
+        uint16_t Type;
+        uint16_t Code;
+        std::string_view Name;
+        uint8_t Flags;
+    };
+
+    // names without a built-in counterpart are registered by Initialize
+    static constexpr EvdevKeyName g_EvdevKeyNames[] = {
+            {BTN_LEFT, "Mouse_Left"}, {BTN_RIGHT, "Mouse_Right"}, {BTN_MIDDLE, "Mouse_Middle"},
+            {BTN_SIDE, "Evdev_Mouse_Side"}, {BTN_EXTRA, "Evdev_Mouse_Extra"},
+
+            {KEY_A, "Key_A"}, {KEY_B, "Key_B"}, {KEY_C, "Key_C"}, {KEY_D, "Key_D"}, {KEY_E, "Key_E"},
+            {KEY_F, "Key_F"}, {KEY_G, "Key_G"}, {KEY_H, "Key_H"}, {KEY_I, "Key_I"}, {KEY_J, "Key_J"},
+            {KEY_K, "Key_K"}, {KEY_L, "Key_L"}, {KEY_M, "Key_M"}, {KEY_N, "Key_N"}, {KEY_O, "Key_O"},
+            {KEY_P, "Key_P"}, {KEY_Q, "Key_Q"}, {KEY_R, "Key_R"}, {KEY_S, "Key_S"}, {KEY_T, "Key_T"},
+            {KEY_U, "Key_U"}, {KEY_V, "Key_V"}, {KEY_W, "Key_W"}, {KEY_X, "Key_X"}, {KEY_Y, "Key_Y"},
+            {KEY_Z, "Key_Z"},
+
+            {KEY_0, "Key_0"}, {KEY_1, "Key_1"}, {KEY_2, "Key_2"}, {KEY_3, "Key_3"}, {KEY_4, "Key_4"},
+            {KEY_5, "Key_5"}, {KEY_6, "Key_6"}, {KEY_7, "Key_7"}, {KEY_8, "Key_8"}, {KEY_9, "Key_9"},
+
+            {KEY_F1, "Key_F1"}, {KEY_F2, "Key_F2"}, {KEY_F3, "Key_F3"}, {KEY_F4, "Key_F4"}, {KEY_F5, "Key_F5"},
+            {KEY_F6, "Key_F6"}, {KEY_F7, "Key_F7"}, {KEY_F8, "Key_F8"}, {KEY_F9, "Key_F9"}, {KEY_F10, "Key_F10"},
+            {KEY_F11, "Key_F11"}, {KEY_F12, "Key_F12"}, {KEY_F13, "Key_F13"}, {KEY_F14, "Key_F14"},
+            {KEY_F15, "Key_F15"}, {KEY_F16, "Key_F16"}, {KEY_F17, "Key_F17"}, {KEY_F18, "Key_F18"},
+            {KEY_F19, "Key_F19"}, {KEY_F20, "Key_F20"}, {KEY_F21, "Key_F21"}, {KEY_F22, "Key_F22"},
+            {KEY_F23, "Key_F23"}, {KEY_F24, "Key_F24"},
+
+            {KEY_LEFTCTRL, "Key_LeftCtrl"}, {KEY_LEFTSHIFT, "Key_LeftShift"}, {KEY_LEFTALT, "Key_LeftAlt"},
+            {KEY_LEFTMETA, "Key_LeftSuper"}, {KEY_RIGHTCTRL, "Key_RightCtrl"}, {KEY_RIGHTSHIFT, "Key_RightShift"},
+            {KEY_RIGHTALT, "Key_RightAlt"}, {KEY_RIGHTMETA, "Key_RightSuper"}, {KEY_COMPOSE, "Key_Menu"},
+
+            {KEY_APOSTROPHE, "Key_Apostrophe"}, {KEY_COMMA, "Key_Comma"}, {KEY_MINUS, "Key_Minus"},
+            {KEY_DOT, "Key_Period"}, {KEY_SLASH, "Key_Slash"}, {KEY_SEMICOLON, "Key_Semicolon"},
+            {KEY_EQUAL, "Key_Equal"}, {KEY_LEFTBRACE, "Key_LeftBracket"}, {KEY_BACKSLASH, "Key_Backslash"},
+            {KEY_RIGHTBRACE, "Key_RightBracket"}, {KEY_GRAVE, "Key_GraveAccent"},
+
+            {KEY_CAPSLOCK, "Key_CapsLock"}, {KEY_SCROLLLOCK, "Key_ScrollLock"}, {KEY_NUMLOCK, "Key_NumLock"},
+            {KEY_SYSRQ, "Key_PrintScreen"}, {KEY_PAUSE, "Key_Pause"},
+
+            {KEY_INSERT, "Key_Insert"}, {KEY_DELETE, "Key_Delete"}, {KEY_HOME, "Key_Home"}, {KEY_END, "Key_End"},
+            {KEY_PAGEUP, "Key_PageUp"}, {KEY_PAGEDOWN, "Key_PageDown"},
+
+            {KEY_UP, "Key_ArrowUp"}, {KEY_DOWN, "Key_ArrowDown"}, {KEY_LEFT, "Key_ArrowLeft"},
+            {KEY_RIGHT, "Key_ArrowRight"},
+
+            {KEY_KP0, "Key_Keypad0"}, {KEY_KP1, "Key_Keypad1"}, {KEY_KP2, "Key_Keypad2"}, {KEY_KP3, "Key_Keypad3"},
+            {KEY_KP4, "Key_Keypad4"}, {KEY_KP5, "Key_Keypad5"}, {KEY_KP6, "Key_Keypad6"}, {KEY_KP7, "Key_Keypad7"},
+            {KEY_KP8, "Key_Keypad8"}, {KEY_KP9, "Key_Keypad9"}, {KEY_KPDOT, "Key_KeypadDecimal"},
+            {KEY_KPSLASH, "Key_KeypadDivide"}, {KEY_KPASTERISK, "Key_KeypadMultiply"},
+            {KEY_KPMINUS, "Key_KeypadSubtract"}, {KEY_KPPLUS, "Key_KeypadAdd"}, {KEY_KPENTER, "Key_KeypadEnter"},
+            {KEY_KPEQUAL, "Key_KeypadEqual"},
+
+            {KEY_SPACE, "Key_Space"}, {KEY_ENTER, "Key_Enter"}, {KEY_ESC, "Key_Escape"},
+            {KEY_BACKSPACE, "Key_Backspace"}, {KEY_TAB, "Key_Tab"},
+
+            // gamepads, named after their position as evdev does
+            {BTN_SOUTH, "Evdev_Gamepad_South"}, {BTN_EAST, "Evdev_Gamepad_East"},
+            {BTN_NORTH, "Evdev_Gamepad_North"}, {BTN_WEST, "Evdev_Gamepad_West"},
+            {BTN_TL, "Evdev_Gamepad_LeftBumper"}, {BTN_TR, "Evdev_Gamepad_RightBumper"},
+            {BTN_TL2, "Evdev_Gamepad_LeftTriggerButton"}, {BTN_TR2, "Evdev_Gamepad_RightTriggerButton"},
+            {BTN_SELECT, "Evdev_Gamepad_Select"}, {BTN_START, "Evdev_Gamepad_Start"},
+            {BTN_MODE, "Evdev_Gamepad_Mode"}, {BTN_THUMBL, "Evdev_Gamepad_LeftThumb"},
+            {BTN_THUMBR, "Evdev_Gamepad_RightThumb"}, {BTN_DPAD_UP, "Evdev_Gamepad_DPadUp"},
+            {BTN_DPAD_DOWN, "Evdev_Gamepad_DPadDown"}, {BTN_DPAD_LEFT, "Evdev_Gamepad_DPadLeft"},
+            {BTN_DPAD_RIGHT, "Evdev_Gamepad_DPadRight"}
+    };
+
+    static constexpr EvdevAxisName g_EvdevAxisNames[] = {
+            {EV_REL, REL_X, "Evdev_Mouse_DeltaX", EVDEV_AXIS_FLAG_NONE},
+            {EV_REL, REL_Y, "Evdev_Mouse_DeltaY", EVDEV_AXIS_FLAG_INVERTED},
+            {EV_REL, REL_WHEEL, "Evdev_Mouse_Wheel", EVDEV_AXIS_FLAG_NONE},
+            {EV_REL, REL_HWHEEL, "Evdev_Mouse_HorizontalWheel", EVDEV_AXIS_FLAG_NONE},
+
+            {EV_ABS, ABS_X, "Evdev_Gamepad_LeftStickX", EVDEV_AXIS_FLAG_NONE},
+            {EV_ABS, ABS_Y, "Evdev_Gamepad_LeftStickY", EVDEV_AXIS_FLAG_INVERTED},
+            {EV_ABS, ABS_RX, "Evdev_Gamepad_RightStickX", EVDEV_AXIS_FLAG_NONE},
+            {EV_ABS, ABS_RY, "Evdev_Gamepad_RightStickY", EVDEV_AXIS_FLAG_INVERTED},
+            {EV_ABS, ABS_Z, "Evdev_Gamepad_LeftTrigger", EVDEV_AXIS_FLAG_UNIPOLAR},
+            {EV_ABS, ABS_RZ, "Evdev_Gamepad_RightTrigger", EVDEV_AXIS_FLAG_UNIPOLAR},
+            {EV_ABS, ABS_HAT0X, "Evdev_Gamepad_DPadX", EVDEV_AXIS_FLAG_NONE},
+            {EV_ABS, ABS_HAT0Y, "Evdev_Gamepad_DPadY", EVDEV_AXIS_FLAG_INVERTED}
+    };
+
+    // handles by event code, 0 for the codes that aren't translated
+    struct EvdevTranslationTable {
+        std::array<InputKeyHandle, KEY_CNT> Keys{};
+        std::array<InputAxisHandle, REL_CNT> RelativeAxes{};
+        std::array<InputAxisHandle, ABS_CNT> AbsoluteAxes{};
+        std::array<uint8_t, REL_CNT> RelativeFlags{};
+        std::array<uint8_t, ABS_CNT> AbsoluteFlags{};
+    };
+
+    static constexpr EvdevTranslationTable BuildEvdevTranslationTable() {
+        EvdevTranslationTable table;
+
+        for (const auto &key: g_EvdevKeyNames) {
+            table.Keys[key.Code] = FNVConstHash(key.Name);
+        }
+
+        for (const auto &axis: g_EvdevAxisNames) {
+            if (axis.Type == EV_REL) {
+                table.RelativeAxes[axis.Code] = FNVConstHash(axis.Name);
+                table.RelativeFlags[axis.Code] = axis.Flags;
+            } else {
+                table.AbsoluteAxes[axis.Code] = FNVConstHash(axis.Name);
+                table.AbsoluteFlags[axis.Code] = axis.Flags;
+            }
+        }
+
+        return table;
+    }
+
+    static constexpr EvdevTranslationTable g_EvdevTable = BuildEvdevTranslationTable();
+
+    static uint64_t GetEventTimestamp(const input_event &event) {
+        return static_cast<uint64_t>(event.input_event_sec) * 1000000000ull +
+               static_cast<uint64_t>(event.input_event_usec) * 1000ull;
+    }
+#endif
+
+    InputEvdevDevice::InputEvdevDevice(std::filesystem::path path, int playerId)
+            : m_Path{std::move(path)}, m_PlayerId{playerId} {}
+
+    InputEvdevDevice::InputEvdevDevice(int fd, std::string name, int playerId)
+            : m_Name{std::move(name)}, m_PlayerId{playerId}, m_Fd{fd}, b_AdoptedFd{true} {}
+
+    InputEvdevDevice::~InputEvdevDevice() {
+        Destroy();
+    }
+
+    std::vector<std::filesystem::path> InputEvdevDevice::FindDevices(const std::filesystem::path &directory) {
+        std::vector<std::filesystem::path> devices;
+        std::error_code error;
+
+        for (const auto &entry: std::filesystem::directory_iterator(directory, error)) {
+            if (entry.path().filename().string().starts_with("event")) {
+                devices.push_back(entry.path());
+            }
+        }
+
+        // event10 after event9
+        std::sort(devices.begin(), devices.end(), [](const auto &a, const auto &b) {
+            auto nameA = a.filename().string(), nameB = b.filename().string();
+            return nameA.size() != nameB.size() ? nameA.size() < nameB.size() : nameA < nameB;
+        });
+
+        return devices;
+    }
+
+    bool InputEvdevDevice::Initialize() {
+#ifdef __linux__
+        if (!b_AdoptedFd) {
+            m_Fd = open(m_Path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        } else if (m_Fd >= 0) {
+            fcntl(m_Fd, F_SETFL, fcntl(m_Fd, F_GETFL) | O_NONBLOCK);
+        }
+
+        if (m_Fd < 0) {
+            g_LoggerInputEvdevDevice.Log(runtime::LOG_LEVEL_ERROR, "Failed to open evdev device '%s'!",
+                                         m_Path.string().c_str());
+            return false;
+        }
+
+        // only succeeds on actual evdev nodes; pipes and captures keep whatever clock they were recorded with
+        int clock = CLOCK_MONOTONIC;
+        b_MonotonicTimestamps = ioctl(m_Fd, EVIOCSCLOCKID, &clock) == 0;
+
+        if (b_MonotonicTimestamps) {
+            char name[256]{};
+
+            if (m_Name.empty() && ioctl(m_Fd, EVIOCGNAME(sizeof(name) - 1), name) > 0) {
+                m_Name = name;
+            }
+
+            for (const auto &axis: g_EvdevAxisNames) {
+                input_absinfo info{};
+                auto &range = m_AbsoluteRanges[axis.Code];
+
+                if (axis.Type == EV_ABS && range.Maximum <= range.Minimum &&
+                    ioctl(m_Fd, EVIOCGABS(axis.Code), &info) == 0) {
+                    range = {info.minimum, info.maximum};
+                }
+            }
+        }
+
+        if (m_Name.empty()) {
+            m_Name = m_Path.filename().string();
+        }
+
+        // the names of the keys and axes this backend adds on top of the built-in ones
+        for (const auto &key: g_EvdevKeyNames) {
+            if (!g_BuiltinKeyTable.Contains(FNVConstHash(key.Name))) {
+                InputKeyRepository::Instance().AddKey(key.Name);
+            }
+        }
+
+        for (const auto &axis: g_EvdevAxisNames) {
+            InputAxisRepository::Instance().AddAxis(axis.Name);
+        }
+
+        m_ReadBuffer.resize(BatchSize * sizeof(input_event));
+        m_PendingBytes = 0;
+        m_KeyBits = {};
+        m_AbsoluteKnown = 0;
+        m_RelativeMoved = m_RelativeActive = 0;
+        b_Dropping = false;
+        b_Disconnected = false;
+
+        return true;
+#else
+        g_LoggerInputEvdevDevice.Log(runtime::LOG_LEVEL_ERROR, "evdev devices are only available on Linux!");
+        return false;
+#endif
+    }
+
+    void InputEvdevDevice::Destroy() {
+#ifdef __linux__
+        if (m_Fd >= 0) {
+            close(m_Fd);
+        }
+#endif
+
+        m_Fd = -1;
+        m_ReadBuffer = {};
+        m_PendingBytes = 0;
+    }
+
+    void InputEvdevDevice::Poll() {
+#ifdef __linux__
+        while (m_Fd >= 0 && !b_Disconnected && !m_ReadBuffer.empty()) {
+            size_t space = m_ReadBuffer.size() - m_PendingBytes;
+            ssize_t result = read(m_Fd, m_ReadBuffer.data() + m_PendingBytes, space);
+
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    g_LoggerInputEvdevDevice.Log(runtime::LOG_LEVEL_WARNING, "Lost evdev device '%s': %s",
+                                                 m_Name.c_str(), std::strerror(errno));
+                    b_Disconnected = true;
+                }
+
+                break;
+            }
+
+            // only pipes and files end; an unplugged device fails with ENODEV instead
+            if (result == 0) {
+                g_LoggerInputEvdevDevice.Log(runtime::LOG_LEVEL_WARNING, "evdev stream '%s' ended", m_Name.c_str());
+                b_Disconnected = true;
+                break;
+            }
+
+            size_t available = m_PendingBytes + static_cast<size_t>(result);
+            size_t count = available / sizeof(input_event);
+
+            ProcessEvents(m_ReadBuffer.data(), count);
+
+            m_PendingBytes = available - count * sizeof(input_event);
+            std::memmove(m_ReadBuffer.data(), m_ReadBuffer.data() + count * sizeof(input_event), m_PendingBytes);
+
+            // a short read means the device is drained
+            if (static_cast<size_t>(result) < space) {
+                break;
+            }
+        }
+#endif
+    }
+
+    void InputEvdevDevice::ProcessEvents(const uint8_t *data, size_t count) {
+#ifdef __linux__
+        auto manager = m_Manager ? m_Manager : InputManager::Instance();
+
+        for (size_t i = 0; i < count; ++i) {
+            input_event event;
+            std::memcpy(&event, data + i * sizeof(input_event), sizeof(event));
+
+            uint64_t timestamp = b_MonotonicTimestamps ? GetEventTimestamp(event) : 0;
+
+            if (event.type == EV_SYN) {
+                if (event.code == SYN_DROPPED) {
+                    g_LoggerInputEvdevDevice.Log(runtime::LOG_LEVEL_WARNING,
+                                                 "evdev device '%s' dropped events; resynchronizing.",
+                                                 m_Name.c_str());
+                    b_Dropping = true;
+                } else if (event.code == SYN_REPORT && b_Dropping) {
+                    b_Dropping = false;
+                    ResyncKeys(timestamp);
+                    ResyncAbsoluteAxes(timestamp);
+                } else if (event.code == SYN_REPORT) {
+                    // relative axes that stopped moving go back to rest
+                    for (uint32_t stopped = m_RelativeActive & ~m_RelativeMoved; stopped; stopped &= stopped - 1) {
+                        manager->PushAxisChange(g_EvdevTable.RelativeAxes[std::countr_zero(stopped)], 0.0f, timestamp);
+                    }
+
+                    m_RelativeActive = m_RelativeMoved;
+                    m_RelativeMoved = 0;
+                }
+
+                continue;
+            }
+
+            if (b_Dropping) {
+                continue;
+            }
+
+            switch (event.type) {
+                case EV_KEY:
+                    // 2 is an auto-repeat, which doesn't change the state
+                    if (event.code < KEY_CNT && event.value != 2) {
+                        PushKey(event.code, event.value != 0, timestamp);
+                    }
+
+                    break;
+                case EV_REL:
+                    if (event.code < REL_CNT && g_EvdevTable.RelativeAxes[event.code] != 0) {
+                        float value = static_cast<float>(event.value);
+                        value = g_EvdevTable.RelativeFlags[event.code] & EVDEV_AXIS_FLAG_INVERTED ? -value : value;
+
+                        manager->PushAxisChange(g_EvdevTable.RelativeAxes[event.code], value, timestamp);
+                        m_RelativeMoved |= uint32_t{1} << event.code;
+                    }
+
+                    break;
+                case EV_ABS:
+                    if (event.code < ABS_CNT && g_EvdevTable.AbsoluteAxes[event.code] != 0) {
+                        PushAbsolute(event.code, event.value, timestamp);
+                    }
+
+                    break;
+                default:
+                    break;
+            }
+        }
+#endif
+    }
+
+    void InputEvdevDevice::PushKey(uint16_t code, bool state, uint64_t timestamp) {
+#ifdef __linux__
+        uint64_t mask = uint64_t{1} << (code & 63);
+        m_KeyBits[code >> 6] = state ? m_KeyBits[code >> 6] | mask : m_KeyBits[code >> 6] & ~mask;
+
+        if (g_EvdevTable.Keys[code] != 0) {
+            auto manager = m_Manager ? m_Manager : InputManager::Instance();
+            manager->PushKeyStateChange(g_EvdevTable.Keys[code], state, timestamp);
+        }
+#endif
+    }
+
+    void InputEvdevDevice::PushAbsolute(uint16_t code, int32_t value, uint64_t timestamp) {
+#ifdef __linux__
+        m_AbsoluteValues[code] = value;
+        m_AbsoluteKnown |= uint64_t{1} << code;
+
+        auto manager = m_Manager ? m_Manager : InputManager::Instance();
+        manager->PushAxisChange(g_EvdevTable.AbsoluteAxes[code], NormalizeAbsolute(code, value), timestamp);
+#endif
+    }
+
+    void InputEvdevDevice::ResyncKeys(uint64_t timestamp) {
+#ifdef __linux__
+        std::array<uint64_t, 12> keyBits{};
+
+        if (ioctl(m_Fd, EVIOCGKEY(sizeof(keyBits)), keyBits.data()) < 0) {
+            return;
+        }
+
+        for (size_t word = 0; word < keyBits.size(); ++word) {
+            for (uint64_t changed = keyBits[word] ^ m_KeyBits[word]; changed; changed &= changed - 1) {
+                auto code = static_cast<uint16_t>(word * 64 + std::countr_zero(changed));
+                PushKey(code, (keyBits[word] >> (code & 63)) & 1, timestamp);
+            }
+        }
+#endif
+    }
+
+    void InputEvdevDevice::ResyncAbsoluteAxes(uint64_t timestamp) {
+#ifdef __linux__
+        for (uint16_t code = 0; code < ABS_CNT; ++code) {
+            input_absinfo info{};
+
+            if (g_EvdevTable.AbsoluteAxes[code] == 0 || ioctl(m_Fd, EVIOCGABS(code), &info) < 0) {
+                continue;
+            }
+
+            // e.g. a stick released while the events were dropped would stay deflected otherwise
+            if (!((m_AbsoluteKnown >> code) & 1) || info.value != m_AbsoluteValues[code]) {
+                PushAbsolute(code, info.value, timestamp);
+            }
+        }
+#endif
+    }
+
+    float InputEvdevDevice::NormalizeAbsolute(uint16_t code, int32_t value) const {
+#ifdef __linux__
+        const auto &range = m_AbsoluteRanges[code];
+        uint8_t flags = g_EvdevTable.AbsoluteFlags[code];
+
+        // unknown range: passed on as it is
+        if (range.Maximum <= range.Minimum) {
+            return static_cast<float>(value);
+        }
+
+        float position = static_cast<float>(std::clamp(value, range.Minimum, range.Maximum) - range.Minimum) /
+                         static_cast<float>(range.Maximum - range.Minimum);
+        float normalized = flags & EVDEV_AXIS_FLAG_UNIPOLAR ? position : position * 2.0f - 1.0f;
+
+        return flags & EVDEV_AXIS_FLAG_INVERTED ? -normalized : normalized;
+#else
+        return static_cast<float>(value);
+#endif
+    }
+
+    void InputEvdevDevice::SetAbsoluteRange(uint16_t code, int32_t minimum, int32_t maximum) {
+        if (code < m_AbsoluteRanges.size()) {
+            m_AbsoluteRanges[code] = {minimum, maximum};
+        }
+    }
+
+    std::string InputEvdevDevice::GetName() const {
+        return m_Name.empty() ? m_Path.filename().string() : m_Name;
+    }
+
+    int InputEvdevDevice::GetPlayerId() {
+        return m_PlayerId;
+    }
+
+    InputWaitHandle InputEvdevDevice::GetWaitHandle() {
+        return m_Fd >= 0 ? m_Fd : INPUT_WAIT_HANDLE_INVALID;
+    }
+}
@@ -0,0 +1,79 @@
+#include <Engine/Input/InputEventFilter.hpp>
+
+#include <Engine/Core/Platform.hpp>
+
+namespace engine::input {
+    bool InputVirtualKeyboardFilter::BeginBatch() {
+        m_Keyboard = core::Platform::GetVirtualKeyboard();
+        m_IgnoreTarget = m_Keyboard && m_Keyboard->IsVisible() ? m_Keyboard->GetInputIgnoreTarget()
+                                                               : INPUT_IGNORE_TARGET_NONE;
+
+        if (m_IgnoreTarget == INPUT_IGNORE_TARGET_NONE) {
+            return false;
+        }
+
+        b_HasBounds = (m_IgnoreTarget & INPUT_IGNORE_TARGET_TOUCH) != 0 &&
+                      m_Keyboard->GetKeyboardBounds(m_BoundsMin, m_BoundsMax);
+
+        return true;
+    }
+
+    void InputVirtualKeyboardFilter::Filter(InputEvent *events, size_t count) {
+        bool ignoreKeys = (m_IgnoreTarget & INPUT_IGNORE_TARGET_KEY) != 0;
+        bool ignoreTouches = (m_IgnoreTarget & INPUT_IGNORE_TARGET_TOUCH) != 0;
+
+        if (ignoreTouches && b_HasBounds) {
+            // branch-free over the whole batch: no calls into the keyboard, one rectangle test per event
+            float minX = m_BoundsMin.x, minY = m_BoundsMin.y, maxX = m_BoundsMax.x, maxY = m_BoundsMax.y;
+
+            for (size_t i = 0; i < count; ++i) {
+                auto &event = events[i];
+
+                bool isKey = event.Type == INPUT_EVENT_TYPE_KEY_STATE_CHANGE;
+                bool isTouch = event.Type == INPUT_EVENT_TYPE_TOUCH_DOWN || event.Type == INPUT_EVENT_TYPE_TOUCH_MOVE;
+                bool isOnKeyboard = (event.Pointer.X >= minX) & (event.Pointer.X <= maxX) &
+                                    (event.Pointer.Y >= minY) & (event.Pointer.Y <= maxY);
+
+                bool reject = (isKey & ignoreKeys) | (isTouch & isOnKeyboard);
+                event.Flags |= reject ? INPUT_EVENT_FLAG_FILTERED : INPUT_EVENT_FLAG_NONE;
+            }
+
+            return;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            auto &event = events[i];
+
+            switch (event.Type) {
+                case INPUT_EVENT_TYPE_KEY_STATE_CHANGE:
+                    if (ignoreKeys) {
+                        event.Flags |= INPUT_EVENT_FLAG_FILTERED;
+                    }
+
+                    break;
+                case INPUT_EVENT_TYPE_TOUCH_DOWN:
+                case INPUT_EVENT_TYPE_TOUCH_MOVE:
+                    if (ignoreTouches && m_Keyboard->IsPointOnKeyboard(event.Pointer.GetPosition())) {
+                        event.Flags |= INPUT_EVENT_FLAG_FILTERED;
+                    }
+
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    bool InputEventTypeFilter::BeginBatch() {
+        m_BatchBlockedTypes = GetBlockedTypes();
+        return m_BatchBlockedTypes != INPUT_EVENT_MASK_NONE;
+    }
+
+    void InputEventTypeFilter::Filter(InputEvent *events, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            bool reject = events[i].Type < INPUT_EVENT_TYPE_COUNT &&
+                          (m_BatchBlockedTypes & InputEventMaskOf(events[i].Type)) != 0;
+            events[i].Flags |= reject ? INPUT_EVENT_FLAG_FILTERED : INPUT_EVENT_FLAG_NONE;
+        }
+    }
+}
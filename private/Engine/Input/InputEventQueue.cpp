@@ -0,0 +1,85 @@
+#include <Engine/Input/InputEventQueue.hpp>
+
+namespace engine::input {
+    static size_t RoundUpToPowerOfTwo(size_t value) {
+        size_t result = 2;
+
+        while (result < value) {
+            result <<= 1;
+        }
+
+        return result;
+    }
+
+    InputEventQueue::InputEventQueue(size_t capacity) : m_EnqueuePos{0}, m_DequeuePos{0}, m_DroppedCount{0} {
+        capacity = RoundUpToPowerOfTwo(capacity);
+
+        m_Slots = std::make_unique<Slot[]>(capacity);
+        m_Mask = capacity - 1;
+
+        // every slot starts out as writable for the producer that claims its position
+        for (size_t i = 0; i < capacity; ++i) {
+            m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool InputEventQueue::Push(const InputEvent &event) {
+        size_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+        Slot *slot;
+
+        for (;;) {
+            slot = &m_Slots[pos & m_Mask];
+
+            size_t seq = slot->Sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            if (diff == 0) {
+                // the slot is free; try to claim it
+                if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // the consumer hasn't released this slot yet, so the queue is full
+                m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                // another producer got there first
+                pos = m_EnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->Event = event;
+        slot->Sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    size_t InputEventQueue::Drain(std::vector<InputEvent> &out) {
+        size_t count = 0;
+
+        for (;;) {
+            Slot &slot = m_Slots[m_DequeuePos & m_Mask];
+
+            // stop at the first slot that is either empty or still being written by a producer
+            if (slot.Sequence.load(std::memory_order_acquire) != m_DequeuePos + 1) {
+                break;
+            }
+
+            out.emplace_back(slot.Event);
+            slot.Sequence.store(m_DequeuePos + m_Mask + 1, std::memory_order_release);
+
+            ++m_DequeuePos;
+            ++count;
+        }
+
+        return count;
+    }
+
+    uint64_t InputEventQueue::ConsumeDroppedCount() {
+        return m_DroppedCount.exchange(0, std::memory_order_relaxed);
+    }
+
+    size_t InputEventQueue::GetCapacity() const {
+        return m_Mask + 1;
+    }
+}
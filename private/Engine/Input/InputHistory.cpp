@@ -0,0 +1,78 @@
+#include <Engine/Input/InputHistory.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace engine::input {
+    InputHistory::InputHistory(size_t capacity) : m_Capacity(std::bit_ceil(capacity > 0 ? capacity : 1)) {}
+
+    void InputHistory::Push(uint64_t timestamp, double value) {
+        if (value == GetLatestValue()) {
+            return;
+        }
+
+        if (m_Samples.empty()) {
+            m_Samples.resize(m_Capacity);
+        }
+
+        // the queries binary search the ring, so it has to stay sorted even if a producer delivers a stamped event
+        // late
+        if (m_Count > 0) {
+            timestamp = std::max(timestamp, At(m_Count - 1).Timestamp);
+        }
+
+        if (m_Count == m_Capacity) {
+            m_EvictedValue = At(0).Value;
+            m_Head = (m_Head + 1) & (m_Capacity - 1);
+            --m_Count;
+        }
+
+        m_Samples[(m_Head + m_Count) & (m_Capacity - 1)] = {timestamp, value};
+        ++m_Count;
+    }
+
+    size_t InputHistory::Find(uint64_t timestamp, bool inclusive) const {
+        size_t first = 0, count = m_Count;
+
+        while (count > 0) {
+            size_t step = count / 2;
+            uint64_t sampleTimestamp = At(first + step).Timestamp;
+
+            if (inclusive ? sampleTimestamp < timestamp : sampleTimestamp <= timestamp) {
+                first += step + 1;
+                count -= step + 1;
+            } else {
+                count = step;
+            }
+        }
+
+        return first;
+    }
+
+    double InputHistory::GetValueAt(uint64_t timestamp) const {
+        size_t index = Find(timestamp, false);
+        return index > 0 ? At(index - 1).Value : m_EvictedValue;
+    }
+
+    size_t InputHistory::GetTransitions(uint64_t begin, uint64_t end,
+                                        std::vector<InputHistorySample> &transitions) const {
+        if (begin >= end) {
+            return 0;
+        }
+
+        size_t first = Find(begin, true);
+        size_t last = Find(end, true);
+
+        for (size_t i = first; i < last; ++i) {
+            transitions.push_back(At(i));
+        }
+
+        return last - first;
+    }
+
+    void InputHistory::Clear() {
+        m_Head = 0;
+        m_Count = 0;
+        m_EvictedValue = 0.0;
+    }
+}
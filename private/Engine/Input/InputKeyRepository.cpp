@@ -1,4 +1,5 @@
 #include <Engine/Input/InputKeyRepository.hpp>
+#include <Engine/Input/InputBuiltinKeys.hpp>
 #include <Engine/Core/Hashing/FNV.hpp>
 
 namespace engine::input {
@@ -7,18 +8,27 @@ namespace engine::input {
         return g_InputKeyRepository;
     }
 
-    std::string InputKeyRepository::GetKey(InputKeyHandle handle) {
-        return m_KeyList.at(handle);
+    std::string_view InputKeyRepository::GetKey(InputKeyHandle handle) const {
+        if (g_BuiltinKeyTable.Contains(handle)) {
+            return g_BuiltinKeyTable.GetName(handle);
+        }
+
+        return m_KeyList.Find(handle);
     }
 
-    bool InputKeyRepository::HasKey(InputKeyHandle handle) {
-        return m_KeyList.contains(handle);
+    bool InputKeyRepository::HasKey(InputKeyHandle handle) const {
+        return g_BuiltinKeyTable.Contains(handle) || m_KeyList.Contains(handle);
     }
 
     InputKeyHandle InputKeyRepository::AddKey(std::string_view key) {
         // hash the key name for easier identification
         InputKeyHandle handle = engine::FNVConstHash(key);
-        m_KeyList[handle] = key;
+
+        // built-in keys are already known at compile time
+        if (!g_BuiltinKeyTable.Contains(handle)) {
+            m_KeyList.Add(handle, key);
+        }
+
         return handle;
     }
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include <Engine/Input/InputLatencyHistogram.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine::input {
+    void InputLatencyHistogram::Snapshot::Merge(const Snapshot &other) {
+        for (size_t i = 0; i < BucketCount; ++i) {
+            Counts[i] += other.Counts[i];
+        }
+
+        TotalCount += other.TotalCount;
+        Sum += other.Sum;
+        Max = std::max(Max, other.Max);
+    }
+
+    double InputLatencyHistogram::Snapshot::GetMean() const {
+        return TotalCount > 0 ? static_cast<double>(Sum) / static_cast<double>(TotalCount) : 0.0;
+    }
+
+    uint64_t InputLatencyHistogram::Snapshot::GetValueAtPercentile(double percentile) const {
+        // the buckets may be slightly ahead of the total while the writer is recording, so count them ourselves
+        uint64_t total = 0;
+
+        for (auto count: Counts) {
+            total += count;
+        }
+
+        if (total == 0) {
+            return 0;
+        }
+
+        auto target = static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 *
+                                                      static_cast<double>(total)));
+        uint64_t seen = 0;
+
+        for (size_t i = 0; i < BucketCount; ++i) {
+            seen += Counts[i];
+
+            if (seen >= std::max<uint64_t>(target, 1)) {
+                // never report more than what was actually recorded
+                return std::min(GetBucketUpperBound(i), Max);
+            }
+        }
+
+        return Max;
+    }
+
+    void InputLatencyHistogram::Record(uint64_t nanoseconds) {
+        Increment(m_Counts[GetBucketIndex(nanoseconds)], 1);
+        Increment(m_TotalCount, 1);
+        Increment(m_Sum, nanoseconds);
+
+        if (nanoseconds > m_Max.load(std::memory_order_relaxed)) {
+            m_Max.store(nanoseconds, std::memory_order_relaxed);
+        }
+    }
+
+    InputLatencyHistogram::Snapshot InputLatencyHistogram::GetSnapshot() const {
+        Snapshot snapshot;
+
+        for (size_t i = 0; i < BucketCount; ++i) {
+            snapshot.Counts[i] = m_Counts[i].load(std::memory_order_relaxed);
+        }
+
+        snapshot.TotalCount = m_TotalCount.load(std::memory_order_relaxed);
+        snapshot.Sum = m_Sum.load(std::memory_order_relaxed);
+        snapshot.Max = m_Max.load(std::memory_order_relaxed);
+
+        return snapshot;
+    }
+
+    void InputLatencyHistogram::Reset() {
+        for (auto &count: m_Counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+
+        m_TotalCount.store(0, std::memory_order_relaxed);
+        m_Sum.store(0, std::memory_order_relaxed);
+        m_Max.store(0, std::memory_order_relaxed);
+    }
+}
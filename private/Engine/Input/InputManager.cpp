@@ -2,29 +2,54 @@
 
 #include <Engine/Input/InputManager.hpp>
 #include <Engine/Input/IInputDevice.hpp>
+#include <Engine/Input/InputPollGroup.hpp>
+#include <Engine/Input/InputClock.hpp>
+#include <Engine/Input/InputTrace.hpp>
 
 #include <Engine/Core/Platform.hpp>
 #include <Engine/Runtime/Logger.hpp>
 
-// define to print debugging messages when pushing events.
-//#define INPUT_MANAGER_DEBUG_EVENTS
+#include <algorithm>
+#include <iterator>
 
 namespace engine::input {
     static InputManager *g_InputManager;
     static runtime::Logger g_LoggerInputManager("InputManager");
 
-    InputManager::InputManager() : b_IsInit{false}, m_Thread{nullptr} {
+    // manager whose listeners and filters the calling thread is running, if any
+    static thread_local const InputManager *g_DispatchingManager = nullptr;
+
+    InputManager::InputManager(const InputManagerConfig &config) : m_EventQueue{config.EventQueueCapacity},
+                                                                   m_NextListenerToken{1}, b_IsInit{false},
+                                                                   m_PollInterval{DefaultPollInterval},
+                                                                   b_CoalesceEvents{false},
+                                                                   b_TrackLatency{config.TrackLatency} {
         mtx_InputProc = core::Platform::CreateMutex();
+        mtx_DispatchProc = core::Platform::CreateMutex();
         mtx_DeviceProc = core::Platform::CreateMutex();
+
+        if (config.TrackLatency) {
+            m_LatencyHistograms = std::make_unique<std::atomic<InputLatencyHistogram *>[]>(LatencyHistogramCount);
+        }
+
+        auto table = std::make_shared<DispatchTable>();
+
+        if (config.FilterVirtualKeyboard) {
+            table->Filters.emplace_back(&m_VirtualKeyboardFilter);
+        }
+
+        m_DispatchTable = std::move(table);
     }
 
     InputManager::~InputManager() {
-        if (mtx_InputProc) {
-            mtx_InputProc = nullptr;
-        }
+        // the poll threads use the mutexes and the dedicated group list, so they have to be gone before any member
+        // is. devices still registered are destroyed whether or not the manager was ever initialized.
+        mtx_InputProc->Lock();
+        ReleaseDevices();
+        mtx_InputProc->Unlock();
 
-        if (mtx_DeviceProc) {
-            mtx_DeviceProc = nullptr;
+        for (size_t i = 0; m_LatencyHistograms && i < LatencyHistogramCount; ++i) {
+            delete m_LatencyHistograms[i].load(std::memory_order_relaxed);
         }
     }
 
@@ -37,29 +62,75 @@ namespace engine::input {
     }
 
     std::vector<IInputDevice *> InputManager::GetDevices() {
-        return m_DeviceList;
+        std::vector<IInputDevice *> devices;
+
+        mtx_DeviceProc->Lock();
+
+        if (m_SharedPollGroup) {
+            m_SharedPollGroup->CollectDevices(devices);
+        }
+
+        for (auto &group: m_DedicatedPollGroups) {
+            group->CollectDevices(devices);
+        }
+
+        mtx_DeviceProc->Unlock();
+
+        return devices;
+    }
+
+    void InputManager::SetPollInterval(std::chrono::microseconds interval) {
+        m_PollInterval.store(interval, std::memory_order_relaxed);
+
+        mtx_DeviceProc->Lock();
+
+        if (m_SharedPollGroup) {
+            m_SharedPollGroup->Wake();
+        }
+
+        for (auto &group: m_DedicatedPollGroups) {
+            group->Wake();
+        }
+
+        mtx_DeviceProc->Unlock();
+    }
+
+    std::chrono::microseconds InputManager::GetPollInterval() const {
+        return m_PollInterval.load(std::memory_order_relaxed);
+    }
+
+    void InputManager::SetEventCoalescing(bool enabled) {
+        b_CoalesceEvents.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool InputManager::IsEventCoalescingEnabled() const {
+        return b_CoalesceEvents.load(std::memory_order_relaxed);
     }
 
     void InputManager::Initialize() {
         mtx_InputProc->Lock();
+        mtx_DeviceProc->Lock();
 
         g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Initializing input manager...");
-        g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Creating input thread...");
-        m_Thread = core::Platform::CreateThread();
+        g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Creating input threads...");
 
-        if (!m_Thread) {
+        if (!GetSharedPollGroup().Start()) {
             g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_ERROR, "Failed to create input thread!");
+            mtx_DeviceProc->Unlock();
             mtx_InputProc->Unlock();
             return;
         }
 
-        m_Thread->SetName("Input Management Thread");
-        m_Thread->SetTaskFunc(&InputManager::ProcessTask, this);
-        m_Thread->Start();
-        g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Created input thread!");
+        for (auto &group: m_DedicatedPollGroups) {
+            group->Start();
+        }
+
+        g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Created input threads!");
         g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_INFO, "Initialized input manager!");
 
         b_IsInit = true;
+
+        mtx_DeviceProc->Unlock();
         mtx_InputProc->Unlock();
     }
 
@@ -68,121 +139,207 @@ namespace engine::input {
 
         mtx_InputProc->Lock();
 
+        g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Shutting down the input manager...");
+        g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Shutting down the input threads...");
+
+        ReleaseDevices();
+
+        mtx_InputProc->Unlock();
+    }
+
+    void InputManager::ReleaseDevices() {
+        mtx_DeviceProc->Lock();
+        // taken under the device lock, so that a device isolated while the threads stop doesn't get a started group
         b_IsInit = false;
+        auto sharedPollGroup = m_SharedPollGroup.get();
+        mtx_DeviceProc->Unlock();
 
-        g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Shutting down the input manager...");
+        // the shared thread takes the device lock when isolating a slow device, so it must be stopped without it
+        if (sharedPollGroup) {
+            sharedPollGroup->Stop();
+        }
+
+        mtx_DeviceProc->Lock();
 
-        if(m_Thread) {
-            g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Shutting down the input thread...");
+        for (auto &group: m_DedicatedPollGroups) {
+            group->Stop();
+        }
 
-            m_Thread->Stop();
-            m_Thread->Join();
-            m_Thread = nullptr;
+        // their devices are gone already; stopping releases the ones the exiting threads didn't get to
+        for (auto &group: m_RetiredPollGroups) {
+            group->Stop();
         }
 
+        m_RetiredPollGroups.clear();
+
         g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Destroying device resources...");
-        for (auto device: m_DeviceList) {
+
+        std::vector<IInputDevice *> devices;
+
+        if (m_SharedPollGroup) {
+            m_SharedPollGroup->CollectDevices(devices);
+        }
+
+        for (auto &group: m_DedicatedPollGroups) {
+            group->CollectDevices(devices);
+        }
+
+        for (auto device: devices) {
             g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Destroying resources for '%s'",
                                      device->GetName().c_str());
+            if (m_SharedPollGroup) {
+                m_SharedPollGroup->RemoveDevice(device);
+            }
+
             device->Destroy();
         }
 
+        m_DeviceIds.clear();
+
         g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_INFO, "Destroyed device resources!");
-        m_DeviceList.clear();
+        m_DedicatedPollGroups.clear();
 
-        mtx_InputProc->Unlock();
+        mtx_DeviceProc->Unlock();
     }
 
     void InputManager::ProcessEvents() {
-        // mutex to make sure that we don't have a race condition when inputs are pushed and processed
+        mtx_DispatchProc->Lock();
+
+        // grab everything the producers pushed so far; this doesn't block them
+        m_DispatchEvents.clear();
+        m_EventQueue.Drain(m_DispatchEvents);
+
+        if (auto dropped = m_EventQueue.ConsumeDroppedCount(); dropped > 0) {
+            InputTrace::Write<INPUT_TRACE_LEVEL_WARNING>(INPUT_TRACE_EVENT_EVENTS_DROPPED, 0, dropped);
+            g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_WARNING,
+                                     "Input event queue overflowed; %llu event(s) were dropped!",
+                                     static_cast<unsigned long long>(dropped));
+        }
+
+        // the queue is filled by several device threads; restore the order in which the input actually happened
+        if (!std::is_sorted(m_DispatchEvents.begin(), m_DispatchEvents.end(), &InputEvent::IsOlderThan)) {
+            std::stable_sort(m_DispatchEvents.begin(), m_DispatchEvents.end(), &InputEvent::IsOlderThan);
+        }
+
+        // listeners and filters run without the lock, on the table current at this point, so that they may add or
+        // remove listeners themselves and never hold up the threads doing so
         mtx_InputProc->Lock();
 
-        // process events
-        for (auto &ev: m_Events) {
-            if (core::Platform::GetVirtualKeyboard() && core::Platform::GetVirtualKeyboard()->IsVisible()) {
-                switch (ev.Type) {
-                    case INPUT_EVENT_TYPE_KEY_STATE_CHANGE:
-                        if ((core::Platform::GetVirtualKeyboard()->GetInputIgnoreTarget() & INPUT_IGNORE_TARGET_KEY) >
-                            0) {
-#ifdef INPUT_MANAGER_DEBUG_EVENTS
-                            g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_WARNING,
-                                                     "Virtual keyboard is shown on screen; ignoring key state change event.");
-#endif
-                            continue;
-                        }
-
-                        break;
-                    case INPUT_EVENT_TYPE_TOUCH_DOWN:
-                    case INPUT_EVENT_TYPE_TOUCH_MOVE:
-                        if ((core::Platform::GetVirtualKeyboard()->GetInputIgnoreTarget() & INPUT_IGNORE_TARGET_TOUCH) >
-                            0) {
-                            if (core::Platform::GetVirtualKeyboard()->IsVisible() &&
-                                core::Platform::GetVirtualKeyboard()->IsPointOnKeyboard(ev.Position)) {
-#ifdef INPUT_MANAGER_DEBUG_EVENTS
-                                g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_WARNING,
-                                                         "Virtual keyboard is shown on screen; ignoring touch events.");
-#endif
-                                continue;
-                            }
-                        }
-
-                        break;
-                    default:
-                        break;
-                }
-            }
+        std::shared_ptr<const DispatchTable> table = m_DispatchTable;
 
-            for (const auto &inputDelegate: m_InputDelegates) {
-                if(inputDelegate(ev)) {
-                    g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_WARNING, "Input delegate handled the event; dismissing event.");
-                    break;
-                }
+        if (m_Recorder.IsOpen()) {
+            m_Recorder.Append(m_DispatchEvents.data(), m_DispatchEvents.size());
+        }
+
+        mtx_InputProc->Unlock();
+
+        g_DispatchingManager = this;
+
+        // filtered first, so that a rejected sample never supersedes the ones before it
+        for (auto filter: table->Filters) {
+            if (filter->BeginBatch()) {
+                filter->Filter(m_DispatchEvents.data(), m_DispatchEvents.size());
             }
         }
 
-        // clear event queue
-        if (!m_Events.empty()) {
-            m_Events.clear();
+        if (IsEventCoalescingEnabled()) {
+            CoalesceEvents();
         }
 
-        mtx_InputProc->Unlock();
-    }
+        if (IsLatencyTrackingEnabled()) {
+            RecordLatencies(InputClock::Now());
+        }
 
-    void InputManager::ProcessTask() {
-        while (m_Thread->IsRunning() || b_IsInit) {
-            // poll device inputs
-            mtx_DeviceProc->Lock();
+        // process events
+        for (auto &ev: m_DispatchEvents) {
+            if (ev.Type >= INPUT_EVENT_TYPE_COUNT) {
+                continue;
+            }
 
-            for (auto d: m_DeviceList) {
-                d->Poll();
+            if (ev.Flags & INPUT_EVENT_FLAG_FILTERED) {
+                InputTrace::Write<INPUT_TRACE_LEVEL_DEBUG>(INPUT_TRACE_EVENT_EVENT_FILTERED, ev.Type);
+                continue;
             }
 
-            mtx_DeviceProc->Unlock();
+            static const InputListenerList noListeners;
+
+            DispatchEvent(ev, table->Listeners[ev.Type], ev.Player < table->PlayerListeners.size()
+                                                         ? table->PlayerListeners[ev.Player][ev.Type] : noListeners);
+        }
+
+        g_DispatchingManager = nullptr;
+
+        mtx_DispatchProc->Unlock();
+    }
+
+    std::shared_ptr<InputManager::DispatchTable> InputManager::CopyDispatchTable() const {
+        return std::make_shared<DispatchTable>(*m_DispatchTable);
+    }
+
+    void InputManager::WaitForDispatch() {
+        // the dispatching thread would wait for itself
+        if (g_DispatchingManager == this) {
+            return;
         }
+
+        mtx_DispatchProc->Lock();
+        mtx_DispatchProc->Unlock();
     }
 
-    void InputManager::RegisterDevice(IInputDevice *device) {
+    void InputManager::RegisterDevice(IInputDevice *device, const InputDevicePollConfig &config) {
+        // joined once they go out of scope, after the lock was released
+        std::vector<std::unique_ptr<InputPollGroup>> stoppedGroups;
+
         mtx_DeviceProc->Lock();
 
+        ReapPollGroups(stoppedGroups);
+
         g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_INFO, "Registering device '%s'", device->GetName().c_str());
-        m_DeviceList.emplace_back(device);
+
+        uint8_t deviceId = AcquireDeviceId(device);
+
+        if (config.Dedicated) {
+            CreateDedicatedGroup(device).AddDevice(device, config, deviceId);
+        } else {
+            GetSharedPollGroup().AddDevice(device, config, deviceId);
+        }
 
         mtx_DeviceProc->Unlock();
     }
 
-    void InputManager::UnregisterDevice(IInputDevice *device) {
+    void InputManager::UnregisterDevice(IInputDevice *device, InputDeviceReleasedDelegate onReleased) {
+        // joined once they go out of scope, after the lock was released
+        std::vector<std::unique_ptr<InputPollGroup>> stoppedGroups;
+
         mtx_DeviceProc->Lock();
 
+        ReapPollGroups(stoppedGroups);
+
         g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Unregistering device '%s'", device->GetName().c_str());
 
-        // look for device in our list
-        auto it = std::find(m_DeviceList.begin(), m_DeviceList.end(), device);
+        // look for device in our groups. the group destroys the device once its poll thread is done with it, which
+        // doesn't hold up this call: poll threads are never waited for.
+        bool found = m_SharedPollGroup && m_SharedPollGroup->RemoveDevice(device, nullptr, true, onReleased);
 
-        if (it != m_DeviceList.end()) {
-            m_DeviceList.erase(it);
-            device->Destroy();
-            g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_INFO, "Device '%s' was destroyed successfully!",
-                                     device->GetName().c_str());
+        if (!found) {
+            auto it = std::find_if(m_DedicatedPollGroups.begin(), m_DedicatedPollGroups.end(),
+                                   [device, &onReleased](const std::unique_ptr<InputPollGroup> &group) {
+                                       return group->RemoveDevice(device, nullptr, true, onReleased);
+                                   });
+
+            found = it != m_DedicatedPollGroups.end();
+
+            // dedicated groups only ever poll a single device. the thread is not waited for here, since a device slow
+            // to return from Poll would hold up every other device change; its group is joined once it exited.
+            if (found && (*it)->GetDeviceCount() == 0) {
+                (*it)->RequestStop();
+                m_RetiredPollGroups.emplace_back(std::move(*it));
+                m_DedicatedPollGroups.erase(it);
+            }
+        }
+
+        if (found) {
+            ReleaseDeviceId(device);
         } else {
             g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_WARNING,
                                      "Device '%s' was not registered in the first place!", device->GetName().c_str());
@@ -191,134 +348,447 @@ namespace engine::input {
         mtx_DeviceProc->Unlock();
     }
 
-    void InputManager::PushEvent(InputEvent event) {
+    InputPollGroup &InputManager::CreateDedicatedGroup(IInputDevice *device) {
+        auto &group = m_DedicatedPollGroups.emplace_back(
+                std::make_unique<InputPollGroup>("Input Thread: " + device->GetName(), m_PollInterval));
+
+        if (b_IsInit) {
+            group->Start();
+        }
+
+        return *group;
+    }
+
+    void InputManager::ReapPollGroups(std::vector<std::unique_ptr<InputPollGroup>> &out) {
+        auto stopped = std::stable_partition(m_RetiredPollGroups.begin(), m_RetiredPollGroups.end(),
+                                             [](const std::unique_ptr<InputPollGroup> &group) {
+                                                 return !group->HasStopped();
+                                             });
+
+        std::move(stopped, m_RetiredPollGroups.end(), std::back_inserter(out));
+        m_RetiredPollGroups.erase(stopped, m_RetiredPollGroups.end());
+    }
+
+    InputPollGroup &InputManager::GetSharedPollGroup() {
+        if (!m_SharedPollGroup) {
+            m_SharedPollGroup = std::make_unique<InputPollGroup>("Input Management Thread", m_PollInterval,
+                                                                 [this](IInputDevice *device) {
+                                                                     IsolateDevice(device);
+                                                                 });
+
+            if (b_IsInit) {
+                m_SharedPollGroup->Start();
+            }
+        }
+
+        return *m_SharedPollGroup;
+    }
+
+    void InputManager::IsolateDevice(IInputDevice *device) {
+        mtx_DeviceProc->Lock();
+
+        InputDevicePollConfig config;
+
+        // the device may have been unregistered in the meantime
+        if (m_SharedPollGroup && m_SharedPollGroup->RemoveDevice(device, &config)) {
+            g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_WARNING,
+                                     "Device '%s' exceeded its poll budget; moving it to a dedicated thread.",
+                                     device->GetName().c_str());
+
+            config.Dedicated = true;
+            CreateDedicatedGroup(device).AddDevice(device, config, FindDeviceId(device));
+        }
+
+        mtx_DeviceProc->Unlock();
+    }
+
+    uint8_t InputManager::AcquireDeviceId(IInputDevice *device) {
+        auto slot = std::find(m_DeviceIds.begin(), m_DeviceIds.end(), nullptr);
+
+        if (slot == m_DeviceIds.end()) {
+            // ids have to fit into InputEvent::Device
+            if (m_DeviceIds.size() >= UINT8_MAX) {
+                g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_WARNING,
+                                         "Out of device ids; events of '%s' won't be attributed to it.",
+                                         device->GetName().c_str());
+                return INPUT_DEVICE_ID_NONE;
+            }
+
+            slot = m_DeviceIds.insert(slot, nullptr);
+        }
+
+        *slot = device;
+        return static_cast<uint8_t>(slot - m_DeviceIds.begin() + 1);
+    }
+
+    uint8_t InputManager::FindDeviceId(IInputDevice *device) const {
+        auto slot = std::find(m_DeviceIds.begin(), m_DeviceIds.end(), device);
+        return slot != m_DeviceIds.end() ? static_cast<uint8_t>(slot - m_DeviceIds.begin() + 1) : INPUT_DEVICE_ID_NONE;
+    }
+
+    void InputManager::ReleaseDeviceId(IInputDevice *device) {
+        auto slot = std::find(m_DeviceIds.begin(), m_DeviceIds.end(), device);
+
+        if (slot != m_DeviceIds.end()) {
+            *slot = nullptr;
+        }
+    }
+
+    void InputManager::AddEventFilter(IInputEventFilter *filter) {
+        mtx_InputProc->Lock();
+
+        auto &filters = m_DispatchTable->Filters;
+
+        if (std::find(filters.begin(), filters.end(), filter) == filters.end()) {
+            auto table = CopyDispatchTable();
+            table->Filters.emplace_back(filter);
+            m_DispatchTable = std::move(table);
+        }
+
+        mtx_InputProc->Unlock();
+    }
+
+    void InputManager::RemoveEventFilter(IInputEventFilter *filter) {
+        mtx_InputProc->Lock();
+
+        auto &filters = m_DispatchTable->Filters;
+        bool found = std::find(filters.begin(), filters.end(), filter) != filters.end();
+
+        if (found) {
+            auto table = CopyDispatchTable();
+            std::erase(table->Filters, filter);
+            m_DispatchTable = std::move(table);
+        }
+
+        mtx_InputProc->Unlock();
+
+        if (found) {
+            WaitForDispatch();
+        }
+    }
+
+    bool InputManager::StartRecording(const std::filesystem::path &path) {
         mtx_InputProc->Lock();
-        m_Events.emplace_back(event);
+        bool isOpen = m_Recorder.Open(path);
         mtx_InputProc->Unlock();
+
+        if (!isOpen) {
+            g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_ERROR, "Failed to start recording input to '%s'!",
+                                     path.string().c_str());
+        }
+
+        return isOpen;
     }
 
-    void InputManager::PushInputChar(uint16_t ch) {
-        InputEvent event{INPUT_EVENT_TYPE_INPUT_CHAR};
-        event.UInputChar = ch;
+    void InputManager::StopRecording() {
+        mtx_InputProc->Lock();
+        m_Recorder.Close();
+        mtx_InputProc->Unlock();
+    }
+
+    bool InputManager::IsRecording() {
+        mtx_InputProc->Lock();
+        bool isOpen = m_Recorder.IsOpen();
+        mtx_InputProc->Unlock();
 
-        PushEvent(event);
+        return isOpen;
     }
 
-    void InputManager::PushAxisChange(InputAxisHandle axis, float value) {
-        InputEvent event{INPUT_EVENT_TYPE_AXIS_CHANGE};
+    void InputManager::SetLatencyTracking(bool enabled) {
+        b_TrackLatency.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool InputManager::IsLatencyTrackingEnabled() const {
+        return m_LatencyHistograms && b_TrackLatency.load(std::memory_order_relaxed);
+    }
 
-        event.Axis = axis;
-        event.AxisValue = value;
+    InputLatencyHistogram::Snapshot InputManager::GetLatencyHistogram(InputLatencySource source, InputEventType type,
+                                                                      IInputDevice *device) {
+        InputLatencyHistogram::Snapshot snapshot;
 
-#ifdef INPUT_MANAGER_DEBUG_EVENTS
-        g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Pushing axis change event for axis 0x%08x: %f", axis, value);
-#endif
+        if (!m_LatencyHistograms || source >= INPUT_LATENCY_SOURCE_COUNT || type >= INPUT_EVENT_TYPE_COUNT) {
+            return snapshot;
+        }
 
-        PushEvent(event);
+        uint32_t firstDevice = 0;
+        uint32_t lastDevice = UINT8_MAX;
+
+        if (device) {
+            mtx_DeviceProc->Lock();
+            firstDevice = lastDevice = FindDeviceId(device);
+            mtx_DeviceProc->Unlock();
+
+            if (firstDevice == INPUT_DEVICE_ID_NONE) {
+                return snapshot;
+            }
+        }
+
+        for (uint32_t id = firstDevice; id <= lastDevice; ++id) {
+            auto histogram = m_LatencyHistograms[GetLatencyHistogramSlot(source, static_cast<uint8_t>(id), type)].load(
+                    std::memory_order_acquire);
+
+            if (histogram) {
+                snapshot.Merge(histogram->GetSnapshot());
+            }
+        }
+
+        return snapshot;
     }
 
-    void InputManager::PushKeyStateChange(InputKeyHandle key, bool newKeyState) {
-        if (!InputKeyRepository::Instance().HasKey(key)) {
-            g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_WARNING,
-                                     "Can't push key state change: key handle %08x is not part of the key registry!",
-                                     key);
-            return;
+    void InputManager::ResetLatencyHistograms() {
+        for (size_t i = 0; m_LatencyHistograms && i < LatencyHistogramCount; ++i) {
+            if (auto histogram = m_LatencyHistograms[i].load(std::memory_order_acquire)) {
+                histogram->Reset();
+            }
+        }
+    }
+
+    void InputManager::RecordLatencies(uint64_t now) {
+        auto record = [this](InputLatencySource source, const InputEvent &event, uint64_t latency) {
+            auto &slot = m_LatencyHistograms[GetLatencyHistogramSlot(source, event.Device, event.Type)];
+            auto histogram = slot.load(std::memory_order_relaxed);
+
+            // only this thread creates histograms, so there's no race to publish them
+            if (!histogram) {
+                histogram = new InputLatencyHistogram();
+                slot.store(histogram, std::memory_order_release);
+            }
+
+            histogram->Record(latency);
+        };
+
+        for (auto &event: m_DispatchEvents) {
+            if (event.Type >= INPUT_EVENT_TYPE_COUNT) {
+                continue;
+            }
+
+            record(INPUT_LATENCY_SOURCE_PUSH, event, now > event.Timestamp ? now - event.Timestamp : 0);
+
+            if (event.HardwareTimestamp != 0) {
+                record(INPUT_LATENCY_SOURCE_HARDWARE, event,
+                       now > event.HardwareTimestamp ? now - event.HardwareTimestamp : 0);
+            }
         }
+    }
 
-        InputEvent event{INPUT_EVENT_TYPE_KEY_STATE_CHANGE};
+    void InputManager::CoalesceEvents() {
+        // walk the batch backwards: the first sample found for a key is the latest one, every earlier sample of the
+        // same key is superseded until a discrete event is crossed.
+        m_CoalesceKeys.clear();
 
-        event.Key = key;
-        event.KeyState = newKeyState;
+        for (auto it = m_DispatchEvents.rbegin(); it != m_DispatchEvents.rend(); ++it) {
+            uint64_t key;
+
+            // rejected events reach no listener, so they neither supersede a sample nor act as a barrier
+            if (it->Flags & INPUT_EVENT_FLAG_FILTERED) {
+                continue;
+            }
 
-#ifdef INPUT_MANAGER_DEBUG_EVENTS
-        g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG,
-                                 "Pushing key state change event: KeyHandle: 0x%08x / Name: %s / State: %s", key,
-                                 InputKeyRepository::Instance().GetKey(key).c_str(), newKeyState ? "DOWN" : "UP");
-#endif
+            switch (it->Type) {
+                case INPUT_EVENT_TYPE_MOUSE_POSITION:
+                    key = static_cast<uint64_t>(it->Type) << 32;
+                    break;
+                case INPUT_EVENT_TYPE_TOUCH_MOVE:
+                    key = static_cast<uint64_t>(it->Type) << 32 | static_cast<uint32_t>(it->Pointer.Finger);
+                    break;
+                case INPUT_EVENT_TYPE_AXIS_CHANGE:
+                    key = static_cast<uint64_t>(it->Type) << 32 | it->Axis.Handle;
+                    break;
+                default:
+                    // key edges, chars and touch up/down keep their position relative to the samples around them
+                    m_CoalesceKeys.clear();
+                    continue;
+            }
 
-        PushEvent(event);
+            if (std::find(m_CoalesceKeys.begin(), m_CoalesceKeys.end(), key) != m_CoalesceKeys.end()) {
+                it->Flags |= INPUT_EVENT_FLAG_SUPERSEDED;
+            } else {
+                m_CoalesceKeys.emplace_back(key);
+            }
+        }
+    }
+
+    void InputManager::PushEvent(InputEvent event, uint64_t hardwareTimestamp) {
+        auto polling = InputPollGroup::GetPollingDevice();
+        event.Device = polling.Device;
+        event.Player = polling.Player;
+
+        // events coming from different device threads are put back into order by their timestamp on dispatch
+        event.Timestamp = InputClock::Now();
+        event.HardwareTimestamp = hardwareTimestamp;
+
+        // lock-free; if the queue is full the event is dropped and reported by the next ProcessEvents call
+        m_EventQueue.Push(event);
+    }
+
+    bool InputManager::PushRecordedEvent(InputEvent event) {
+        // the recorded timestamps and device ids belong to another run, and the batch is coalesced anew
+        event.Device = InputPollGroup::GetPollingDevice().Device;
+        event.Flags = INPUT_EVENT_FLAG_NONE;
+        event.Timestamp = InputClock::Now();
+        event.HardwareTimestamp = 0;
+
+        return m_EventQueue.Push(event);
+    }
+
+    void InputManager::PushInputChar(uint16_t ch, uint64_t hardwareTimestamp) {
+        InputTrace::Write<INPUT_TRACE_LEVEL_VERBOSE>(INPUT_TRACE_EVENT_CHAR_PUSHED, ch);
+
+        PushEvent(InputEvent::MakeInputChar(ch), hardwareTimestamp);
     }
 
-    void InputManager::PushMousePosition(core::math::Vector2 position) {
-        InputEvent event{INPUT_EVENT_TYPE_MOUSE_POSITION};
+    void InputManager::PushAxisChange(InputAxisHandle axis, float value, uint64_t hardwareTimestamp) {
+        InputTrace::Write<INPUT_TRACE_LEVEL_VERBOSE>(INPUT_TRACE_EVENT_AXIS_PUSHED, axis, InputTrace::FloatArg(value));
+
+        PushEvent(InputEvent::MakeAxisChange(axis, value), hardwareTimestamp);
+    }
+
+    void InputManager::PushKeyStateChange(InputKeyHandle key, bool newKeyState, uint64_t hardwareTimestamp) {
+        // keys that aren't part of the key registry can't be pushed
+        if (!InputKeyRepository::Instance().HasKey(key)) {
+            InputTrace::Write<INPUT_TRACE_LEVEL_WARNING>(INPUT_TRACE_EVENT_KEY_REJECTED, key);
+            return;
+        }
+
+        InputTrace::Write<INPUT_TRACE_LEVEL_VERBOSE>(INPUT_TRACE_EVENT_KEY_PUSHED, key, newKeyState);
 
-        event.Position = position;
+        PushEvent(InputEvent::MakeKeyStateChange(key, newKeyState), hardwareTimestamp);
+    }
 
-#ifdef INPUT_MANAGER_DEBUG_EVENTS
-        g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Pushing mouse position event: %ix%i",
-                                 (int) position.x, (int) position.y);
-#endif
+    void InputManager::PushMousePosition(core::math::Vector2 position, uint64_t hardwareTimestamp) {
+        InputTrace::Write<INPUT_TRACE_LEVEL_VERBOSE>(INPUT_TRACE_EVENT_POINTER_PUSHED, INPUT_EVENT_TYPE_MOUSE_POSITION,
+                                                     InputTrace::PositionArg(position.x, position.y));
 
-        PushEvent(event);
+        PushEvent(InputEvent::MakePointer(INPUT_EVENT_TYPE_MOUSE_POSITION, 0, position), hardwareTimestamp);
     }
 
-    void InputManager::PushTouchMove(int fingerId, core::math::Vector2 position) {
-        InputEvent event{INPUT_EVENT_TYPE_TOUCH_MOVE};
+    void InputManager::PushTouchMove(int fingerId, core::math::Vector2 position, uint64_t hardwareTimestamp) {
+        InputTrace::Write<INPUT_TRACE_LEVEL_VERBOSE>(INPUT_TRACE_EVENT_POINTER_PUSHED, INPUT_EVENT_TYPE_TOUCH_MOVE,
+                                                     InputTrace::PositionArg(position.x, position.y));
 
-        event.TouchFinger = fingerId;
-        event.Position = position;
+        PushEvent(InputEvent::MakePointer(INPUT_EVENT_TYPE_TOUCH_MOVE, fingerId, position), hardwareTimestamp);
+    }
 
-#ifdef INPUT_MANAGER_DEBUG_EVENTS
-        g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Pushing touch move event for finger %i: %ix%i",
-                                 fingerId, (int) position.x, (int) position.y);
-#endif
+    void InputManager::PushTouchUp(int fingerId, core::math::Vector2 position, uint64_t hardwareTimestamp) {
+        InputTrace::Write<INPUT_TRACE_LEVEL_VERBOSE>(INPUT_TRACE_EVENT_POINTER_PUSHED, INPUT_EVENT_TYPE_TOUCH_UP,
+                                                     InputTrace::PositionArg(position.x, position.y));
 
-        PushEvent(event);
+        PushEvent(InputEvent::MakePointer(INPUT_EVENT_TYPE_TOUCH_UP, fingerId, position), hardwareTimestamp);
     }
 
-    void InputManager::PushTouchUp(int fingerId, core::math::Vector2 position) {
-        InputEvent event{INPUT_EVENT_TYPE_TOUCH_UP};
+    void InputManager::PushTouchDown(int fingerId, core::math::Vector2 position, uint64_t hardwareTimestamp) {
+        InputTrace::Write<INPUT_TRACE_LEVEL_VERBOSE>(INPUT_TRACE_EVENT_POINTER_PUSHED, INPUT_EVENT_TYPE_TOUCH_DOWN,
+                                                     InputTrace::PositionArg(position.x, position.y));
 
-        event.TouchFinger = fingerId;
-        event.Position = position;
+        PushEvent(InputEvent::MakePointer(INPUT_EVENT_TYPE_TOUCH_DOWN, fingerId, position), hardwareTimestamp);
+    }
 
-#ifdef INPUT_MANAGER_DEBUG_EVENTS
-        g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Pushing touch up event for finger %i: %ix%i",
-                                 fingerId, (int) position.x, (int) position.y);
-#endif
+    void InputManager::InsertListener(InputListenerList &listeners, const InputListener &listener) {
+        // behind every listener of the same or a higher priority
+        auto position = std::find_if(listeners.begin(), listeners.end(), [&listener](const InputListener &other) {
+            return other.Priority < listener.Priority;
+        });
 
-        PushEvent(event);
+        listeners.insert(position, listener);
     }
 
-    void InputManager::PushTouchDown(int fingerId, core::math::Vector2 position) {
-        InputEvent event{INPUT_EVENT_TYPE_TOUCH_DOWN};
+    bool InputManager::EraseListener(InputListenerList &listeners, InputListenerToken token) {
+        auto it = std::find_if(listeners.begin(), listeners.end(), [token](const InputListener &listener) {
+            return listener.Token.Id == token.Id;
+        });
 
-        event.TouchFinger = fingerId;
-        event.Position = position;
+        if (it == listeners.end()) {
+            return false;
+        }
 
-#ifdef INPUT_MANAGER_DEBUG_EVENTS
-        g_LoggerInputManager.Log(engine::runtime::LOG_LEVEL_DEBUG, "Pushing touch down event for finger %i: %ix%i",
-                                 fingerId, (int) position.x, (int) position.y);
-#endif
+        listeners.erase(it);
+        return true;
+    }
 
-        PushEvent(event);
+    void InputManager::DispatchEvent(const InputEvent &event, const InputListenerList &listeners,
+                                     const InputListenerList &playerListeners) {
+        bool isSuperseded = (event.Flags & INPUT_EVENT_FLAG_SUPERSEDED) != 0;
+        auto it = listeners.begin(), playerIt = playerListeners.begin();
+
+        // both lists are sorted by priority, then by subscription order, which tokens follow
+        while (it != listeners.end() || playerIt != playerListeners.end()) {
+            bool takePlayer = it == listeners.end() ||
+                              (playerIt != playerListeners.end() &&
+                               (playerIt->Priority > it->Priority ||
+                                (playerIt->Priority == it->Priority && playerIt->Token.Id < it->Token.Id)));
+            const auto &listener = takePlayer ? *playerIt++ : *it++;
+
+            if (isSuperseded && !listener.ReceivesSupersededSamples) {
+                continue;
+            }
+
+            if (listener.Delegate(event)) {
+                InputTrace::Write<INPUT_TRACE_LEVEL_DEBUG>(INPUT_TRACE_EVENT_EVENT_CONSUMED, event.Type,
+                                                           listener.Token.Id);
+                break;
+            }
+        }
     }
 
-    void InputManager::AddInputListener(InputEventDelegate listener, bool hasHighPriority) {
+    InputListenerToken InputManager::AddInputListener(InputEventDelegate listener, InputEventMask eventMask,
+                                                      int32_t priority, bool receiveSupersededSamples,
+                                                      int32_t player) {
+        if (!listener || player < INPUT_LISTENER_PLAYER_ALL || player > INPUT_PLAYER_ID_NONE) {
+            return {};
+        }
+
         mtx_InputProc->Lock();
 
-        if(hasHighPriority) {
-            m_InputDelegates.insert(m_InputDelegates.begin(), std::move(listener));
-        } else {
-            m_InputDelegates.push_back(std::move(listener));
+        InputListener entry{listener, {m_NextListenerToken++}, priority, receiveSupersededSamples};
+        auto table = CopyDispatchTable();
+
+        if (player != INPUT_LISTENER_PLAYER_ALL && static_cast<size_t>(player) >= table->PlayerListeners.size()) {
+            table->PlayerListeners.resize(player + 1);
         }
 
+        InputListenerList *lists = player == INPUT_LISTENER_PLAYER_ALL ? table->Listeners
+                                                                     : table->PlayerListeners[player].data();
+
+        for (uint32_t type = 0; type < INPUT_EVENT_TYPE_COUNT; ++type) {
+            if ((eventMask & InputEventMaskOf(static_cast<InputEventType>(type))) != 0) {
+                InsertListener(lists[type], entry);
+            }
+        }
+
+        m_DispatchTable = std::move(table);
+
         mtx_InputProc->Unlock();
+
+        return entry.Token;
     }
 
-    void InputManager::RemoveInputListener(InputEventDelegate listener) {
+    bool InputManager::RemoveInputListener(InputListenerToken token) {
+        bool found = false;
+
         mtx_InputProc->Lock();
 
-        m_InputDelegates.erase(
-                std::remove_if(m_InputDelegates.begin(), m_InputDelegates.end(),
-                               [&listener](const InputEventDelegate &existingHandler) {
-                                   return existingHandler.target_type() == listener.target_type() &&
-                                          existingHandler.target<void(InputEvent)>() ==
-                                          listener.target<void(InputEvent)>();
-                               }),
-                m_InputDelegates.end()
-        );
+        auto table = CopyDispatchTable();
+
+        for (auto &listeners: table->Listeners) {
+            found |= EraseListener(listeners, token);
+        }
+
+        for (auto &lists: table->PlayerListeners) {
+            for (auto &listeners: lists) {
+                found |= EraseListener(listeners, token);
+            }
+        }
+
+        if (found) {
+            m_DispatchTable = std::move(table);
+        }
 
         mtx_InputProc->Unlock();
+
+        if (found) {
+            WaitForDispatch();
+        }
+
+        return found;
     }
 }
\ No newline at end of file
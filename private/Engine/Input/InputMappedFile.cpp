@@ -0,0 +1,81 @@
+#include <Engine/Input/InputMappedFile.hpp>
+
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define INPUT_MAPPED_FILE_USE_MMAP
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace engine::input {
+    InputMappedFile::~InputMappedFile() {
+        Close();
+    }
+
+    bool InputMappedFile::Open(const std::filesystem::path &path) {
+        Close();
+
+#ifdef INPUT_MAPPED_FILE_USE_MMAP
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat info{};
+
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void *data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (data != MAP_FAILED) {
+                m_Data = static_cast<const uint8_t *>(data);
+                m_Size = static_cast<size_t>(info.st_size);
+                b_IsMapped = true;
+            }
+        }
+
+        // the mapping stays valid after the descriptor is closed
+        close(fd);
+
+        if (b_IsMapped) {
+            return true;
+        }
+#endif
+
+        std::ifstream stream(path, std::ios::binary | std::ios::ate);
+
+        if (!stream) {
+            return false;
+        }
+
+        m_Buffer.resize(static_cast<size_t>(stream.tellg()));
+        stream.seekg(0);
+
+        if (!stream.read(reinterpret_cast<char *>(m_Buffer.data()), static_cast<std::streamsize>(m_Buffer.size()))) {
+            m_Buffer.clear();
+            return false;
+        }
+
+        m_Data = m_Buffer.data();
+        m_Size = m_Buffer.size();
+
+        return true;
+    }
+
+    void InputMappedFile::Close() {
+#ifdef INPUT_MAPPED_FILE_USE_MMAP
+        if (b_IsMapped) {
+            munmap(const_cast<uint8_t *>(m_Data), m_Size);
+        }
+#endif
+
+        m_Data = nullptr;
+        m_Size = 0;
+        b_IsMapped = false;
+        m_Buffer.clear();
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine::input {
+    // Read-only view of a whole file. Memory-mapped on POSIX platforms, read into memory everywhere else.
+    struct InputMappedFile {
+        InputMappedFile() = default;
+
+        ~InputMappedFile();
+
+        InputMappedFile(const InputMappedFile &) = delete;
+
+        InputMappedFile &operator=(const InputMappedFile &) = delete;
+
+        bool Open(const std::filesystem::path &path);
+
+        void Close();
+
+        const uint8_t *GetData() const {
+            return m_Data;
+        }
+
+        size_t GetSize() const {
+            return m_Size;
+        }
+
+    protected:
+        const uint8_t *m_Data{nullptr};
+        size_t m_Size{0};
+        bool b_IsMapped{false};
+        std::vector<uint8_t> m_Buffer;
+    };
+}
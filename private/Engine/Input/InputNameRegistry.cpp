@@ -0,0 +1,83 @@
+#include <Engine/Input/InputNameRegistry.hpp>
+
+namespace engine::input {
+    static size_t GetHomeSlot(uint32_t handle, size_t mask) {
+        // handles are already hashes, but the low bits of FNV alone cluster a bit
+        return (handle ^ (handle >> 16)) & mask;
+    }
+
+    InputNameRegistry::InputNameRegistry() : m_Count{0} {
+        m_Tables.emplace_back(std::make_unique<Table>(InitialCapacity));
+        m_Table.store(m_Tables.back().get(), std::memory_order_release);
+    }
+
+    const std::string *InputNameRegistry::FindIn(const Table &table, uint32_t handle) {
+        for (size_t i = GetHomeSlot(handle, table.Mask);; i = (i + 1) & table.Mask) {
+            auto name = table.Slots[i].Name.load(std::memory_order_acquire);
+
+            if (!name) {
+                return nullptr;
+            }
+
+            if (table.Slots[i].Handle.load(std::memory_order_relaxed) == handle) {
+                return name;
+            }
+        }
+    }
+
+    void InputNameRegistry::InsertInto(Table &table, uint32_t handle, const std::string *name) {
+        size_t i = GetHomeSlot(handle, table.Mask);
+
+        while (table.Slots[i].Name.load(std::memory_order_relaxed)) {
+            i = (i + 1) & table.Mask;
+        }
+
+        table.Slots[i].Handle.store(handle, std::memory_order_relaxed);
+        table.Slots[i].Name.store(name, std::memory_order_release);
+    }
+
+    std::string_view InputNameRegistry::Find(uint32_t handle) const {
+        auto name = FindIn(*m_Table.load(std::memory_order_acquire), handle);
+        return name ? std::string_view(*name) : std::string_view{};
+    }
+
+    bool InputNameRegistry::Contains(uint32_t handle) const {
+        return FindIn(*m_Table.load(std::memory_order_acquire), handle) != nullptr;
+    }
+
+    std::string_view InputNameRegistry::Add(uint32_t handle, std::string_view name) {
+        std::lock_guard<std::mutex> lock(mtx_Write);
+
+        Table *table = m_Table.load(std::memory_order_relaxed);
+
+        if (auto existing = FindIn(*table, handle)) {
+            return *existing;
+        }
+
+        const std::string *interned = &m_Names.emplace_back(name);
+
+        // keep the load factor at or below 1/2 so that probe chains stay short
+        if ((m_Count + 1) * 2 > table->Mask + 1) {
+            auto grown = std::make_unique<Table>((table->Mask + 1) * 2);
+
+            for (size_t i = 0; i <= table->Mask; ++i) {
+                if (auto slotName = table->Slots[i].Name.load(std::memory_order_relaxed)) {
+                    InsertInto(*grown, table->Slots[i].Handle.load(std::memory_order_relaxed), slotName);
+                }
+            }
+
+            InsertInto(*grown, handle, interned);
+
+            // older tables are kept alive since readers may still be probing them; they only grow geometrically
+            table = grown.get();
+            m_Tables.emplace_back(std::move(grown));
+            m_Table.store(table, std::memory_order_release);
+        } else {
+            InsertInto(*table, handle, interned);
+        }
+
+        ++m_Count;
+
+        return *interned;
+    }
+}
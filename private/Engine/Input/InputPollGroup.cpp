@@ -0,0 +1,351 @@
+#include <Engine/Input/InputPollGroup.hpp>
+
+#include <Engine/Core/Platform.hpp>
+#include <Engine/Runtime/Logger.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+namespace engine::input {
+    static runtime::Logger g_LoggerInputPollGroup("InputPollGroup");
+
+    // upper bound of readable device handles handled per wake-up of a poll thread
+    static constexpr size_t MaxReadyHandles = 32;
+
+    static thread_local InputPollGroup::PollingDevice g_PollingDevice;
+
+    InputPollGroup::InputPollGroup(std::string name, const std::atomic<std::chrono::microseconds> &defaultInterval,
+                                   BudgetExceededDelegate onBudgetExceeded) : m_Name{std::move(name)},
+                                                                              m_DefaultInterval{defaultInterval},
+                                                                              m_OnBudgetExceeded{std::move(onBudgetExceeded)},
+                                                                              m_DeviceList{new DeviceList()},
+                                                                              b_IsRunning{false} {
+        mtx_DeviceProc = core::Platform::CreateMutex();
+    }
+
+    InputPollGroup::~InputPollGroup() {
+        Stop();
+
+        std::vector<ReleasedDevice> released;
+
+        mtx_DeviceProc->Lock();
+        ReclaimRetired(released);
+        mtx_DeviceProc->Unlock();
+
+        ReleaseDevices(released);
+
+        auto list = m_DeviceList.load(std::memory_order_relaxed);
+
+        for (auto entry: *list) {
+            delete entry;
+        }
+
+        delete list;
+    }
+
+    bool InputPollGroup::Start() {
+        if (b_IsRunning) {
+            return true;
+        }
+
+        m_Thread = core::Platform::CreateThread();
+
+        if (!m_Thread) {
+            g_LoggerInputPollGroup.Log(engine::runtime::LOG_LEVEL_ERROR, "Failed to create poll thread '%s'!",
+                                       m_Name.c_str());
+            return false;
+        }
+
+        b_IsRunning = true;
+        b_HasStopped = false;
+
+        m_Thread->SetName(m_Name.c_str());
+        m_Thread->SetTaskFunc(&InputPollGroup::ProcessTask, this);
+        m_Thread->Start();
+
+        return true;
+    }
+
+    void InputPollGroup::Stop() {
+        if (!m_Thread) {
+            return;
+        }
+
+        b_IsRunning = false;
+
+        m_Thread->Stop();
+        // the thread may be blocked waiting for device input
+        m_Waiter.Wake();
+        m_Thread->Join();
+        m_Thread = nullptr;
+
+        // nothing reads the lists anymore; devices removed in the meantime can go
+        m_ReaderEpoch.store(QuiescentEpoch);
+
+        std::vector<ReleasedDevice> released;
+
+        mtx_DeviceProc->Lock();
+        ReclaimRetired(released);
+        mtx_DeviceProc->Unlock();
+
+        ReleaseDevices(released);
+    }
+
+    void InputPollGroup::RequestStop() {
+        b_IsRunning = false;
+        m_Waiter.Wake();
+    }
+
+    const InputPollGroup::DeviceList &InputPollGroup::EnterDeviceList() {
+        // sequentially consistent: a writer that sees the poll thread quiescent knows it will load a newer list
+        m_ReaderEpoch.store(m_Epoch.load());
+        return *m_DeviceList.load();
+    }
+
+    void InputPollGroup::LeaveDeviceList() {
+        m_ReaderEpoch.store(QuiescentEpoch);
+    }
+
+    void InputPollGroup::PublishDeviceList(DeviceList *list, Entry *removed, bool destroyDevice,
+                                           InputDeviceReleasedDelegate onReleased) {
+        auto previous = m_DeviceList.exchange(list);
+        m_Retired.push_back({previous, removed, destroyDevice, std::move(onReleased), m_Epoch.fetch_add(1)});
+        b_HasRetired.store(true, std::memory_order_relaxed);
+    }
+
+    void InputPollGroup::ReclaimRetired(std::vector<ReleasedDevice> &released) {
+        // the poll thread can only hold lists that were current at or after the epoch it entered at
+        uint64_t readerEpoch = m_ReaderEpoch.load();
+
+        std::erase_if(m_Retired, [&](const RetiredList &retired) {
+            if (readerEpoch != QuiescentEpoch && readerEpoch <= retired.Epoch) {
+                return false;
+            }
+
+            if (retired.Removed && (retired.DestroyDevice || retired.OnReleased)) {
+                released.push_back({retired.Removed->Device, retired.DestroyDevice, retired.OnReleased});
+            }
+
+            delete retired.Removed;
+            delete retired.List;
+            return true;
+        });
+
+        b_HasRetired.store(!m_Retired.empty(), std::memory_order_relaxed);
+    }
+
+    void InputPollGroup::ReleaseDevices(std::vector<ReleasedDevice> &released) {
+        for (auto &device: released) {
+            if (device.Destroy) {
+                device.Device->Destroy();
+                g_LoggerInputPollGroup.Log(engine::runtime::LOG_LEVEL_INFO, "Device '%s' was destroyed successfully!",
+                                           device.Device->GetName().c_str());
+            }
+
+            // last, since the owner may free the device right away
+            if (device.OnReleased) {
+                device.OnReleased(device.Device);
+            }
+        }
+    }
+
+    void InputPollGroup::AddDevice(IInputDevice *device, const InputDevicePollConfig &config, uint8_t deviceId) {
+        InputWaitHandle waitHandle = device->GetWaitHandle();
+
+        if (!m_Waiter.Watch(waitHandle)) {
+            g_LoggerInputPollGroup.Log(engine::runtime::LOG_LEVEL_DEBUG, "Device '%s' will be polled at a fixed rate.",
+                                       device->GetName().c_str());
+            waitHandle = INPUT_WAIT_HANDLE_INVALID;
+        }
+
+        std::vector<ReleasedDevice> released;
+
+        mtx_DeviceProc->Lock();
+
+        auto list = new DeviceList(*m_DeviceList.load(std::memory_order_relaxed));
+        list->push_back(new Entry{device, config, deviceId, waitHandle, std::chrono::steady_clock::now()});
+
+        PublishDeviceList(list, nullptr, false, nullptr);
+        ReclaimRetired(released);
+
+        mtx_DeviceProc->Unlock();
+
+        ReleaseDevices(released);
+
+        // let the poll thread pick up the new device
+        m_Waiter.Wake();
+    }
+
+    bool InputPollGroup::RemoveDevice(IInputDevice *device, InputDevicePollConfig *config, bool destroy,
+                                      InputDeviceReleasedDelegate onReleased) {
+        std::vector<ReleasedDevice> released;
+
+        mtx_DeviceProc->Lock();
+
+        auto current = m_DeviceList.load(std::memory_order_relaxed);
+        auto it = std::find_if(current->begin(), current->end(), [device](const Entry *entry) {
+            return entry->Device == device;
+        });
+
+        bool found = it != current->end();
+
+        if (found) {
+            Entry *entry = *it;
+
+            if (config) {
+                *config = entry->Config;
+            }
+
+            m_Waiter.Unwatch(entry->WaitHandle);
+
+            auto list = new DeviceList();
+            list->reserve(current->size() - 1);
+            std::copy_if(current->begin(), current->end(), std::back_inserter(*list), [entry](const Entry *other) {
+                return other != entry;
+            });
+
+            PublishDeviceList(list, entry, destroy, std::move(onReleased));
+            ReclaimRetired(released);
+        }
+
+        mtx_DeviceProc->Unlock();
+
+        ReleaseDevices(released);
+
+        return found;
+    }
+
+    void InputPollGroup::CollectDevices(std::vector<IInputDevice *> &out) {
+        // writers are the only ones to free lists, so the current one can't go away under the lock
+        mtx_DeviceProc->Lock();
+
+        for (auto entry: *m_DeviceList.load(std::memory_order_relaxed)) {
+            out.emplace_back(entry->Device);
+        }
+
+        mtx_DeviceProc->Unlock();
+    }
+
+    size_t InputPollGroup::GetDeviceCount() {
+        mtx_DeviceProc->Lock();
+        size_t count = m_DeviceList.load(std::memory_order_relaxed)->size();
+        mtx_DeviceProc->Unlock();
+
+        return count;
+    }
+
+    void InputPollGroup::Wake() {
+        m_Waiter.Wake();
+    }
+
+    InputPollGroup::PollingDevice InputPollGroup::GetPollingDevice() {
+        return g_PollingDevice;
+    }
+
+    std::chrono::microseconds InputPollGroup::GetInterval(const Entry &entry) const {
+        if (entry.Config.Interval.count() > 0) {
+            return entry.Config.Interval;
+        }
+
+        return m_DefaultInterval.load(std::memory_order_relaxed);
+    }
+
+    void InputPollGroup::ProcessTask() {
+        InputWaitHandle readyHandles[MaxReadyHandles];
+        std::vector<IInputDevice *> overBudget;
+
+        while (b_IsRunning) {
+            auto now = std::chrono::steady_clock::now();
+            auto timeout = std::chrono::microseconds(-1);
+
+            // devices that can't be waited on bound the wait to their next scheduled poll
+            for (auto entryPointer: EnterDeviceList()) {
+                auto &entry = *entryPointer;
+
+                if (entry.WaitHandle != INPUT_WAIT_HANDLE_INVALID) {
+                    continue;
+                }
+
+                auto untilPoll = std::max(std::chrono::duration_cast<std::chrono::microseconds>(entry.NextPoll - now),
+                                          std::chrono::microseconds(0));
+
+                if (timeout.count() < 0 || untilPoll < timeout) {
+                    timeout = untilPoll;
+                }
+            }
+
+            LeaveDeviceList();
+
+            size_t readyCount = m_Waiter.Wait(timeout, readyHandles, MaxReadyHandles);
+
+            // poll device inputs; entries are only ever touched by this thread once published
+            now = std::chrono::steady_clock::now();
+
+            for (auto entryPointer: EnterDeviceList()) {
+                auto &entry = *entryPointer;
+
+                if (entry.WaitHandle == INPUT_WAIT_HANDLE_INVALID) {
+                    if (now < entry.NextPoll) {
+                        continue;
+                    }
+
+                    entry.NextPoll += GetInterval(entry);
+
+                    // don't try to catch up on missed polls after a stall
+                    if (entry.NextPoll < now) {
+                        entry.NextPoll = now + GetInterval(entry);
+                    }
+                } else if (std::find(readyHandles, readyHandles + readyCount, entry.WaitHandle) ==
+                           readyHandles + readyCount) {
+                    continue;
+                }
+
+                // the player is looked up on every poll, since devices may be reassigned at any time
+                int playerId = entry.Device->GetPlayerId();
+                g_PollingDevice = {entry.DeviceId, playerId >= 0 && playerId < INPUT_PLAYER_ID_NONE
+                                                   ? static_cast<uint8_t>(playerId) : INPUT_PLAYER_ID_NONE};
+
+                auto pollStart = std::chrono::steady_clock::now();
+                entry.Device->Poll();
+
+                if (entry.Config.Budget.count() > 0 && std::chrono::steady_clock::now() - pollStart > entry.Config.Budget) {
+                    overBudget.emplace_back(entry.Device);
+                }
+            }
+
+            g_PollingDevice = {};
+            LeaveDeviceList();
+
+            // devices removed during the sweep are destroyed here rather than by whoever removed them
+            if (b_HasRetired.load(std::memory_order_relaxed)) {
+                std::vector<ReleasedDevice> released;
+
+                mtx_DeviceProc->Lock();
+                ReclaimRetired(released);
+                mtx_DeviceProc->Unlock();
+
+                ReleaseDevices(released);
+            }
+
+            // handled outside of the lock, since the delegate usually moves the device to another group
+            for (auto device: overBudget) {
+                if (m_OnBudgetExceeded) {
+                    m_OnBudgetExceeded(device);
+                }
+            }
+
+            overBudget.clear();
+        }
+
+        // devices removed right before the stop request are released by this thread rather than the joining one
+        std::vector<ReleasedDevice> released;
+
+        mtx_DeviceProc->Lock();
+        ReclaimRetired(released);
+        mtx_DeviceProc->Unlock();
+
+        ReleaseDevices(released);
+
+        b_HasStopped = true;
+    }
+}
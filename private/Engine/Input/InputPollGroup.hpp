@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Engine/Core/Runtime/IThread.hpp>
+#include <Engine/Core/Runtime/IMutex.hpp>
+
+#include <Engine/Input/IInputDevice.hpp>
+#include <Engine/Input/InputManager.hpp>
+#include <Engine/Input/InputDeviceWaiter.hpp>
+
+namespace engine::input {
+    // A set of devices polled by a single thread. The input manager keeps a shared group for regular devices and a
+    // dedicated group for every device that asked for its own thread or exceeded its poll budget in the shared one.
+    // The device list is copy-on-write: changes publish a new immutable list, which the poll thread picks up without
+    // locking. Replaced lists, and the devices removed with them, are reclaimed once the poll thread can no longer
+    // be using them (epoch-based, the poll thread being the only reader), so adding or removing a device never waits
+    // for a poll sweep.
+    struct InputPollGroup {
+        using BudgetExceededDelegate = std::function<void(IInputDevice *)>;
+
+        // identifies the device whose Poll() is running on the calling thread
+        struct PollingDevice {
+            uint8_t Device{INPUT_DEVICE_ID_NONE};
+            uint8_t Player{INPUT_PLAYER_ID_NONE};
+        };
+
+        InputPollGroup(std::string name, const std::atomic<std::chrono::microseconds> &defaultInterval,
+                       BudgetExceededDelegate onBudgetExceeded = nullptr);
+
+        ~InputPollGroup();
+
+        bool Start();
+
+        void Stop();
+
+        // asks the poll thread to stop without waiting for it; Stop, or the destructor, still joins it.
+        void RequestStop();
+
+        // whether the poll thread is gone, or about to be, so that Stop won't block
+        bool HasStopped() const {
+            return b_HasStopped;
+        }
+
+        void AddDevice(IInputDevice *device, const InputDevicePollConfig &config, uint8_t deviceId);
+
+        // detaches the device; returns false if the device isn't part of this group. with "destroy" set, the device
+        // is Destroy()ed as soon as the poll thread is done with it, otherwise it may be in use until the current
+        // sweep ends, unless this is called from the poll thread itself. "onReleased" is called once that happened.
+        bool RemoveDevice(IInputDevice *device, InputDevicePollConfig *config = nullptr, bool destroy = false,
+                          InputDeviceReleasedDelegate onReleased = nullptr);
+
+        void CollectDevices(std::vector<IInputDevice *> &out);
+
+        size_t GetDeviceCount();
+
+        void Wake();
+
+        // events pushed outside of a poll, e.g. from the platform's message loop, belong to no device.
+        static PollingDevice GetPollingDevice();
+
+    protected:
+        struct Entry {
+            IInputDevice *Device;
+            InputDevicePollConfig Config;
+            uint8_t DeviceId;
+            // handle watched by the device waiter; INPUT_WAIT_HANDLE_INVALID for fixed-rate polled devices
+            InputWaitHandle WaitHandle;
+            std::chrono::steady_clock::time_point NextPoll;
+        };
+
+        // immutable once published
+        using DeviceList = std::vector<Entry *>;
+
+        struct RetiredList {
+            const DeviceList *List;
+            // entry removed by the change that retired the list, if any
+            Entry *Removed;
+            bool DestroyDevice;
+            InputDeviceReleasedDelegate OnReleased;
+            // value of m_Epoch when the list was replaced
+            uint64_t Epoch;
+        };
+
+        // removed device the poll thread is done with
+        struct ReleasedDevice {
+            IInputDevice *Device;
+            bool Destroy;
+            InputDeviceReleasedDelegate OnReleased;
+        };
+
+        static constexpr uint64_t QuiescentEpoch = UINT64_MAX;
+
+        // read side, poll thread only: the list stays valid until LeaveDeviceList.
+        const DeviceList &EnterDeviceList();
+
+        void LeaveDeviceList();
+
+        // write side; mtx_DeviceProc must be held.
+        void PublishDeviceList(DeviceList *list, Entry *removed, bool destroyDevice,
+                               InputDeviceReleasedDelegate onReleased);
+
+        // frees the retired lists the poll thread can't see anymore and collects the devices to release once
+        // mtx_DeviceProc is released; mtx_DeviceProc must be held.
+        void ReclaimRetired(std::vector<ReleasedDevice> &released);
+
+        // destroys the devices that asked for it, then notifies their owners
+        static void ReleaseDevices(std::vector<ReleasedDevice> &released);
+
+        void ProcessTask();
+
+        std::chrono::microseconds GetInterval(const Entry &entry) const;
+
+        std::string m_Name;
+        const std::atomic<std::chrono::microseconds> &m_DefaultInterval;
+        BudgetExceededDelegate m_OnBudgetExceeded;
+
+        // serializes the writers and guards m_Retired; never taken around a Poll().
+        std::unique_ptr<core::runtime::IMutex> mtx_DeviceProc;
+        std::atomic<const DeviceList *> m_DeviceList;
+        std::vector<RetiredList> m_Retired;
+        std::atomic<bool> b_HasRetired{false};
+
+        // bumped by every publication; the poll thread announces the epoch it entered the list at, or QuiescentEpoch
+        // while it isn't looking at it
+        std::atomic<uint64_t> m_Epoch{0};
+        std::atomic<uint64_t> m_ReaderEpoch{QuiescentEpoch};
+
+        InputDeviceWaiter m_Waiter;
+        std::unique_ptr<core::runtime::IThread> m_Thread;
+        std::atomic<bool> b_IsRunning;
+        // set by the poll thread once it left its loop; true while no thread was started
+        std::atomic<bool> b_HasStopped{true};
+    };
+}
@@ -0,0 +1,30 @@
+#include <Engine/Input/InputRecording.hpp>
+
+namespace engine::input {
+    bool InputRecorder::Open(const std::filesystem::path &path) {
+        Close();
+
+        m_Stream.open(path, std::ios::binary | std::ios::trunc);
+
+        if (!m_Stream) {
+            return false;
+        }
+
+        InputRecordingHeader header;
+        m_Stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        return static_cast<bool>(m_Stream);
+    }
+
+    void InputRecorder::Close() {
+        if (m_Stream.is_open()) {
+            m_Stream.close();
+        }
+
+        m_Stream.clear();
+    }
+
+    void InputRecorder::Append(const InputEvent *events, size_t count) {
+        m_Stream.write(reinterpret_cast<const char *>(events), static_cast<std::streamsize>(count * sizeof(InputEvent)));
+    }
+}
@@ -0,0 +1,122 @@
+#define SHOW_PRIVATE_API
+
+#include <Engine/Input/InputReplayDevice.hpp>
+#include <Engine/Input/InputManager.hpp>
+#include <Engine/Input/InputRecording.hpp>
+#include <Engine/Input/InputMappedFile.hpp>
+#include <Engine/Input/InputClock.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+#include <cstring>
+
+namespace engine::input {
+    static runtime::Logger g_LoggerInputReplayDevice("InputReplayDevice");
+
+    InputReplayDevice::InputReplayDevice(std::filesystem::path path, double speed, int playerId)
+            : m_Path{std::move(path)}, m_Speed{speed}, m_PlayerId{playerId}, m_EventCount{0}, m_NextEvent{0},
+              m_StartTime{0}, m_FirstTimestamp{0} {}
+
+    InputReplayDevice::~InputReplayDevice() = default;
+
+    bool InputReplayDevice::Initialize() {
+        m_File = std::make_unique<InputMappedFile>();
+
+        InputRecordingHeader header;
+
+        if (!m_File->Open(m_Path) || m_File->GetSize() < sizeof(header)) {
+            g_LoggerInputReplayDevice.Log(runtime::LOG_LEVEL_ERROR, "Failed to open input recording '%s'!",
+                                          m_Path.string().c_str());
+            m_File = nullptr;
+            return false;
+        }
+
+        std::memcpy(&header, m_File->GetData(), sizeof(header));
+
+        if (!header.IsValid()) {
+            g_LoggerInputReplayDevice.Log(runtime::LOG_LEVEL_ERROR, "'%s' is not a compatible input recording!",
+                                          m_Path.string().c_str());
+            m_File = nullptr;
+            return false;
+        }
+
+        // a trailing partial event is left over by recordings that were cut short
+        m_EventCount = (m_File->GetSize() - sizeof(header)) / sizeof(InputEvent);
+
+        if (m_EventCount > 0) {
+            InputEvent first;
+            std::memcpy(&first, m_File->GetData() + sizeof(header), sizeof(first));
+            m_FirstTimestamp = first.Timestamp;
+        }
+
+        Rewind();
+        return true;
+    }
+
+    void InputReplayDevice::Destroy() {
+        m_File = nullptr;
+        m_EventCount = 0;
+        m_NextEvent = 0;
+    }
+
+    void InputReplayDevice::Poll() {
+        if (!m_File) {
+            return;
+        }
+
+        const uint8_t *events = m_File->GetData() + sizeof(InputRecordingHeader);
+
+        // everything recorded up to this point of the original timeline is due
+        uint64_t dueTimestamp = UINT64_MAX;
+
+        if (m_Speed > 0.0) {
+            dueTimestamp = m_FirstTimestamp + static_cast<uint64_t>(static_cast<double>(InputClock::Now() - m_StartTime) *
+                                                                    m_Speed);
+        }
+
+        auto manager = m_Manager ? m_Manager : InputManager::Instance();
+
+        for (; m_NextEvent < m_EventCount; ++m_NextEvent) {
+            InputEvent event;
+            std::memcpy(&event, events + m_NextEvent * sizeof(InputEvent), sizeof(event));
+
+            if (event.Timestamp > dueTimestamp) {
+                break;
+            }
+
+            if (m_PlayerId >= 0 && m_PlayerId < INPUT_PLAYER_ID_NONE) {
+                event.Player = static_cast<uint8_t>(m_PlayerId);
+            }
+
+            // the queue is full; try again on the next poll
+            if (!manager->PushRecordedEvent(event)) {
+                break;
+            }
+        }
+    }
+
+    std::string InputReplayDevice::GetName() const {
+        return "Input Replay (" + m_Path.filename().string() + ")";
+    }
+
+    int InputReplayDevice::GetPlayerId() {
+        return m_PlayerId;
+    }
+
+    void InputReplayDevice::Rewind() {
+        m_NextEvent = 0;
+        m_StartTime = InputClock::Now();
+    }
+
+    bool InputReplayDevice::IsFinished() const {
+        return m_NextEvent >= m_EventCount;
+    }
+
+    size_t InputReplayDevice::GetEventCount() const {
+        return m_EventCount;
+    }
+
+    size_t InputReplayDevice::GetReplayedEventCount() const {
+        return m_NextEvent;
+    }
+}
@@ -0,0 +1,174 @@
+#include <Engine/Input/InputStateSnapshot.hpp>
+#include <Engine/Input/InputBuiltinKeys.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+
+namespace engine::input {
+    static_assert(InputBuiltinKeyTable::SlotCount == 4 * 64, "InputStateSnapshot::BuiltinKeyBits must cover every slot");
+
+    // Word-wise edge detection. Plain loops over 64-bit words with no dependency between iterations, which the
+    // compiler turns into vector XOR/AND; words missing from the previous state count as released.
+    static void DiffBits(const uint64_t *previous, size_t previousCount, const uint64_t *current, size_t count,
+                         uint64_t *pressed, uint64_t *released) {
+        size_t common = std::min(previousCount, count);
+
+        for (size_t i = 0; i < common; ++i) {
+            uint64_t changed = previous[i] ^ current[i];
+            pressed[i] = changed & current[i];
+            released[i] = changed & previous[i];
+        }
+
+        for (size_t i = common; i < count; ++i) {
+            pressed[i] = current[i];
+            released[i] = 0;
+        }
+    }
+
+    static bool AnyBit(const uint64_t *bits, size_t count) {
+        uint64_t any = 0;
+
+        for (size_t i = 0; i < count; ++i) {
+            any |= bits[i];
+        }
+
+        return any != 0;
+    }
+
+    static bool AnyCommonBit(const uint64_t *a, const uint64_t *b, size_t count) {
+        uint64_t any = 0;
+
+        for (size_t i = 0; i < count; ++i) {
+            any |= a[i] & b[i];
+        }
+
+        return any != 0;
+    }
+
+    // both lists are sorted
+    static bool AnyCommonKey(const std::vector<InputKeyHandle> &a, const std::vector<InputKeyHandle> &b) {
+        auto itA = a.begin(), itB = b.begin();
+
+        while (itA != a.end() && itB != b.end()) {
+            if (*itA == *itB) {
+                return true;
+            }
+
+            *itA < *itB ? ++itA : ++itB;
+        }
+
+        return false;
+    }
+
+    static bool TestKey(InputKeyHandle key, const std::array<uint64_t, 4> &builtinBits,
+                        const std::vector<InputKeyHandle> &otherKeys) {
+        if (g_BuiltinKeyTable.Contains(key)) {
+            uint32_t slot = g_BuiltinKeyTable.GetSlot(key);
+            return (builtinBits[slot >> 6] >> (slot & 63)) & 1;
+        }
+
+        return std::binary_search(otherKeys.begin(), otherKeys.end(), key);
+    }
+
+    InputKeyGroup::InputKeyGroup(std::initializer_list<InputKeyHandle> keys) {
+        for (auto key : keys) {
+            Add(key);
+        }
+    }
+
+    void InputKeyGroup::Add(InputKeyHandle key) {
+        if (g_BuiltinKeyTable.Contains(key)) {
+            uint32_t slot = g_BuiltinKeyTable.GetSlot(key);
+            BuiltinKeyBits[slot >> 6] |= uint64_t{1} << (slot & 63);
+            return;
+        }
+
+        auto it = std::lower_bound(OtherKeys.begin(), OtherKeys.end(), key);
+
+        if (it == OtherKeys.end() || *it != key) {
+            OtherKeys.insert(it, key);
+        }
+    }
+
+    double InputStateSnapshot::GetAxis(InputMapHandle mapHandle) const {
+        return GetAxis(Bindings ? Bindings->FindAxis(mapHandle) : InputAxisId{});
+    }
+
+    bool InputStateSnapshot::GetButton(InputMapHandle mapHandle) const {
+        return GetButton(Bindings ? Bindings->FindButton(mapHandle) : InputButtonId{});
+    }
+
+    bool InputStateSnapshot::GetButtonDown(InputMapHandle mapHandle) const {
+        return GetButtonDown(Bindings ? Bindings->FindButton(mapHandle) : InputButtonId{});
+    }
+
+    bool InputStateSnapshot::GetButtonUp(InputMapHandle mapHandle) const {
+        return GetButtonUp(Bindings ? Bindings->FindButton(mapHandle) : InputButtonId{});
+    }
+
+    uint64_t InputStateSnapshot::GetButtonHeldFor(InputMapHandle mapHandle) const {
+        return GetButtonHeldFor(Bindings ? Bindings->FindButton(mapHandle) : InputButtonId{});
+    }
+
+    bool InputStateSnapshot::WasComboTriggered(InputMapHandle mapHandle) const {
+        return WasComboTriggered(Bindings ? Bindings->FindCombo(mapHandle) : InputComboId{});
+    }
+
+    bool InputStateSnapshot::IsKeyDown(InputKeyHandle key) const {
+        return TestKey(key, BuiltinKeyBits, OtherKeysDown);
+    }
+
+    bool InputStateSnapshot::WasKeyPressed(InputKeyHandle key) const {
+        return TestKey(key, BuiltinKeyPressedBits, OtherKeysPressed);
+    }
+
+    bool InputStateSnapshot::WasKeyReleased(InputKeyHandle key) const {
+        return TestKey(key, BuiltinKeyReleasedBits, OtherKeysReleased);
+    }
+
+    bool InputStateSnapshot::IsAnyKeyDown() const {
+        return AnyBit(BuiltinKeyBits.data(), BuiltinKeyBits.size()) || !OtherKeysDown.empty();
+    }
+
+    bool InputStateSnapshot::IsAnyKeyDown(const InputKeyGroup &group) const {
+        return AnyCommonBit(BuiltinKeyBits.data(), group.BuiltinKeyBits.data(), BuiltinKeyBits.size()) ||
+               AnyCommonKey(OtherKeysDown, group.OtherKeys);
+    }
+
+    bool InputStateSnapshot::WasAnyKeyPressed() const {
+        return AnyBit(BuiltinKeyPressedBits.data(), BuiltinKeyPressedBits.size()) || !OtherKeysPressed.empty();
+    }
+
+    bool InputStateSnapshot::WasAnyKeyPressed(const InputKeyGroup &group) const {
+        return AnyCommonBit(BuiltinKeyPressedBits.data(), group.BuiltinKeyBits.data(), BuiltinKeyPressedBits.size()) ||
+               AnyCommonKey(OtherKeysPressed, group.OtherKeys);
+    }
+
+    void InputStateSnapshot::DiffWith(const InputStateSnapshot &previous) {
+        ButtonPressedBits.resize(ButtonBits.size());
+        ButtonReleasedBits.resize(ButtonBits.size());
+        DiffBits(previous.ButtonBits.data(), previous.ButtonBits.size(), ButtonBits.data(), ButtonBits.size(),
+                 ButtonPressedBits.data(), ButtonReleasedBits.data());
+
+        DiffBits(previous.BuiltinKeyBits.data(), previous.BuiltinKeyBits.size(), BuiltinKeyBits.data(),
+                 BuiltinKeyBits.size(), BuiltinKeyPressedBits.data(), BuiltinKeyReleasedBits.data());
+
+        OtherKeysPressed.clear();
+        OtherKeysReleased.clear();
+        std::set_difference(OtherKeysDown.begin(), OtherKeysDown.end(), previous.OtherKeysDown.begin(),
+                            previous.OtherKeysDown.end(), std::back_inserter(OtherKeysPressed));
+        std::set_difference(previous.OtherKeysDown.begin(), previous.OtherKeysDown.end(), OtherKeysDown.begin(),
+                            OtherKeysDown.end(), std::back_inserter(OtherKeysReleased));
+
+        // only the buttons pressed in this snapshot get a new press time, the others keep theirs
+        ButtonPressTimes.assign(previous.ButtonPressTimes.begin(), previous.ButtonPressTimes.end());
+        ButtonPressTimes.resize(ButtonBits.size() * 64, 0);
+
+        for (size_t word = 0; word < ButtonPressedBits.size(); ++word) {
+            for (uint64_t bits = ButtonPressedBits[word]; bits; bits &= bits - 1) {
+                ButtonPressTimes[word * 64 + std::countr_zero(bits)] = Timestamp;
+            }
+        }
+    }
+}
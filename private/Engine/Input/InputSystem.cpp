@@ -1,10 +1,18 @@
 #include <Engine/Input/InputSystem.hpp>
 #include <Engine/Input/InputManager.hpp>
+#include <Engine/Input/InputTrace.hpp>
+#include <Engine/Input/InputClock.hpp>
+#include <Engine/Core/Platform.hpp>
 #include <Engine/Runtime/Logger.hpp>
 #include <Engine/Core/Hashing/FNV.hpp>
+#include <Engine/Input/InputBuiltinKeys.hpp>
+#include <Engine/Input/InputBindingConfig.hpp>
+
+#include <algorithm>
 
 namespace engine::input {
     static InputSystem *g_InputSystem;
+    static InputSystem *g_PlayerInputSystems[InputSystem::MaxLocalPlayers];
     static runtime::Logger g_LoggerInputSystem("InputSystem");
 
     InputSystem *InputSystem::Instance() {
@@ -15,76 +23,475 @@ namespace engine::input {
         return g_InputSystem;
     }
 
+    InputSystem *InputSystem::PlayerInstance(uint8_t player) {
+        if (player >= MaxLocalPlayers) {
+            return nullptr;
+        }
+
+        if (!g_PlayerInputSystems[player]) {
+            g_PlayerInputSystems[player] = new InputSystem(player);
+        }
+
+        return g_PlayerInputSystems[player];
+    }
+
+    InputSystem::InputSystem(int32_t player) : InputSystem(nullptr, player) {}
+
+    InputSystem::InputSystem(InputManager *manager, int32_t player) : m_Manager(manager), m_Player(player) {
+        mtx_Bindings = core::Platform::CreateMutex();
+
+        m_PublishedTable = std::make_shared<InputBindingTable>();
+        AdoptBindingTable(m_PublishedTable, InputClock::Now());
+        m_Snapshots[0].Bindings = m_BindingTable;
+    }
+
+    InputSystem::~InputSystem() {
+        if (m_ListenerToken.IsValid()) {
+            Shutdown();
+        }
+
+        delete m_PendingTable.exchange(nullptr, std::memory_order_acquire);
+    }
+
     void InputSystem::Init() {
         g_LoggerInputSystem.Log(runtime::LOG_LEVEL_DEBUG, "Initializing input system...");
-        InputManager::Instance()->AddInputListener(
-                std::bind(&InputSystem::InternalInputCallback, this, std::placeholders::_1));
+        if (!m_Manager) {
+            m_Manager = InputManager::Instance();
+        }
+
+        m_ListenerToken = m_Manager->AddInputListener(
+                InputEventDelegate::Bind<&InputSystem::InternalInputCallback>(this),
+                InputEventMaskOf(INPUT_EVENT_TYPE_KEY_STATE_CHANGE) | InputEventMaskOf(INPUT_EVENT_TYPE_AXIS_CHANGE) |
+                InputEventMaskOf(INPUT_EVENT_TYPE_MOUSE_POSITION) | InputEventMaskOf(INPUT_EVENT_TYPE_TOUCH_DOWN) |
+                InputEventMaskOf(INPUT_EVENT_TYPE_TOUCH_UP) | InputEventMaskOf(INPUT_EVENT_TYPE_TOUCH_MOVE),
+                INPUT_LISTENER_PRIORITY_DEFAULT, false, m_Player);
         g_LoggerInputSystem.Log(runtime::LOG_LEVEL_INFO, "Input system initialized!");
     }
 
     void InputSystem::Shutdown() {
-        InputManager::Instance()->RemoveInputListener(
-                std::bind(&InputSystem::InternalInputCallback, this, std::placeholders::_1));
+        if (m_Manager) {
+            m_Manager->RemoveInputListener(m_ListenerToken);
+        }
+
+        m_ListenerToken = {};
+    }
+
+    InputAxisId InputSystem::GetAxisId(InputMapHandle mapHandle) const {
+        mtx_Bindings->Lock();
+        auto id = m_PublishedTable->FindAxis(mapHandle);
+        mtx_Bindings->Unlock();
+
+        return id;
+    }
+
+    // the handle and name queries are meant for per-frame use, so they skip the lock and resolve against the table
+    // the dispatch is using.
+    double InputSystem::GetAxis(InputMapHandle mapHandle) const {
+        return GetAxis(m_BindingTable->FindAxis(mapHandle));
+    }
+
+    double InputSystem::GetAxis(std::string_view mapName) const {
+        return GetAxis(FNVConstHash(mapName));
+    }
+
+    InputButtonId InputSystem::GetButtonId(InputMapHandle mapHandle) const {
+        mtx_Bindings->Lock();
+        auto id = m_PublishedTable->FindButton(mapHandle);
+        mtx_Bindings->Unlock();
+
+        return id;
+    }
+
+    bool InputSystem::GetButton(InputMapHandle mapHandle) const {
+        return GetButton(m_BindingTable->FindButton(mapHandle));
+    }
+
+    bool InputSystem::GetButton(std::string_view mapName) const {
+        return GetButton(FNVConstHash(mapName));
+    }
+
+    InputComboId InputSystem::GetComboId(InputMapHandle mapHandle) const {
+        mtx_Bindings->Lock();
+        auto id = m_PublishedTable->FindCombo(mapHandle);
+        mtx_Bindings->Unlock();
+
+        return id;
+    }
+
+    bool InputSystem::WasComboTriggered(std::string_view mapName) const {
+        return WasComboTriggered(FNVConstHash(mapName));
+    }
+
+    const InputHistory &InputSystem::GetAxisHistory(InputAxisId axis) const {
+        static const InputHistory empty;
+        return axis.Index < m_AxisHistories.size() ? m_AxisHistories[axis.Index] : empty;
+    }
+
+    const InputHistory &InputSystem::GetAxisHistory(InputMapHandle mapHandle) const {
+        return GetAxisHistory(m_BindingTable->FindAxis(mapHandle));
+    }
+
+    const InputHistory &InputSystem::GetButtonHistory(InputButtonId button) const {
+        static const InputHistory empty;
+        return button.Index < m_ButtonHistories.size() ? m_ButtonHistories[button.Index] : empty;
+    }
+
+    const InputHistory &InputSystem::GetButtonHistory(InputMapHandle mapHandle) const {
+        return GetButtonHistory(m_BindingTable->FindButton(mapHandle));
+    }
+
+    bool InputSystem::GetButtonDown(std::string_view mapName) const {
+        return GetButtonDown(FNVConstHash(mapName));
+    }
+
+    bool InputSystem::GetButtonUp(std::string_view mapName) const {
+        return GetButtonUp(FNVConstHash(mapName));
+    }
+
+    uint64_t InputSystem::GetButtonHeldFor(std::string_view mapName) const {
+        return GetButtonHeldFor(FNVConstHash(mapName));
+    }
+
+    void InputSystem::SetButtonState(InputButtonId button, bool state) {
+        uint64_t mask = uint64_t{1} << (button.Index & 63);
+
+        if (state) {
+            m_ButtonBits[button.Index >> 6] |= mask;
+        } else {
+            m_ButtonBits[button.Index >> 6] &= ~mask;
+        }
+    }
+
+    void InputSystem::AdoptBindingTable(std::shared_ptr<const InputBindingTable> table, uint64_t timestamp) {
+        // carry the current source values over, the new table may order its sources differently
+        std::vector<float> sourceValues(table->Sources.size(), 0.0f);
+
+        for (size_t i = 0; i < m_SourceValues.size(); ++i) {
+            if (m_SourceValues[i] == 0.0f) {
+                continue;
+            }
+
+            auto sourceIndex = table->FindSource(m_BindingTable->Sources[i].Handle);
+
+            if (sourceIndex != InputBindingTable::NoSource) {
+                sourceValues[sourceIndex] = m_SourceValues[i];
+            }
+        }
+
+        m_BindingTable = std::move(table);
+        InputTrace::Write<INPUT_TRACE_LEVEL_INFO>(INPUT_TRACE_EVENT_BINDINGS_ADOPTED,
+                                                  static_cast<uint32_t>(m_BindingTable->Sources.size()),
+                                                  m_BindingTable->Bindings.size());
+
+        m_SourceValues.assign(m_BindingTable->Sources.size(), 0.0f);
+
+        m_AxisSums.assign(m_BindingTable->GetAxisCount(), 0.0);
+        m_AxisActiveSources.assign(m_BindingTable->GetAxisCount(), 0);
+        m_AxisValues.assign(m_BindingTable->GetAxisCount(), 0.0);
+
+        m_ButtonPressCounts.assign(m_BindingTable->ButtonCount, 0);
+        m_ButtonBits.assign((m_BindingTable->ButtonCount + 63) / 64, 0);
+
+        // accumulate the state again from scratch
+        for (size_t i = 0; i < sourceValues.size(); ++i) {
+            if (sourceValues[i] != 0.0f) {
+                UpdateSource(static_cast<uint32_t>(i), sourceValues[i], 0);
+            }
+        }
+
+        // the histories outlive the tables, ids are stable; only the net effect of the new bindings is recorded
+        m_AxisHistories.resize(m_BindingTable->GetAxisCount());
+        m_ButtonHistories.resize(m_BindingTable->ButtonCount);
+
+        for (uint32_t i = 0; i < m_AxisHistories.size(); ++i) {
+            m_AxisHistories[i].Push(timestamp, m_AxisValues[i]);
+        }
+
+        for (uint32_t i = 0; i < m_ButtonHistories.size(); ++i) {
+            m_ButtonHistories[i].Push(timestamp, GetButton(InputButtonId{i}) ? 1.0 : 0.0);
+        }
+
+        // sequences in progress are dropped, but keys held across the change still count towards chords
+        auto &comboMatcher = m_BindingTable->ComboMatcher;
+        comboMatcher.Reset(m_ComboState);
+
+        for (auto key: comboMatcher.GetKeys()) {
+            if (IsKeyHeld(key)) {
+                comboMatcher.SetHeld(m_ComboState, key);
+            }
+        }
+
+        m_ComboTriggeredBits.resize((m_BindingTable->ComboCount + 63) / 64, 0);
+    }
+
+    void InputSystem::PublishBindings() {
+        m_PublishedTable = m_BindingSet.Compile(m_PublishedTable.get());
+
+        // a table published earlier but not adopted yet is simply replaced; the dispatch never saw it
+        delete m_PendingTable.exchange(new std::shared_ptr<const InputBindingTable>(m_PublishedTable),
+                                       std::memory_order_acq_rel);
     }
 
-    double InputSystem::GetAxis(std::string_view mapName) {
-        return m_AxisState[FNVConstHash(mapName)];
+    void InputSystem::AdoptPendingBindings(uint64_t timestamp) {
+        if (!m_PendingTable.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        std::unique_ptr<std::shared_ptr<const InputBindingTable>> pending(
+                m_PendingTable.exchange(nullptr, std::memory_order_acq_rel));
+
+        if (pending) {
+            AdoptBindingTable(std::move(*pending), timestamp);
+        }
     }
 
-    bool InputSystem::GetButton(std::string_view mapName) {
-        return m_ButtonState[FNVConstHash(mapName)];
+    void InputSystem::UpdateSource(uint32_t sourceIndex, float value, uint64_t timestamp) {
+        float previous = m_SourceValues[sourceIndex];
+
+        if (previous == value) {
+            return;
+        }
+
+        m_SourceValues[sourceIndex] = value;
+
+        // only the bindings of this source are touched; their mappings are updated by the difference
+        auto &source = m_BindingTable->Sources[sourceIndex];
+
+        for (uint32_t i = source.FirstBinding; i < source.FirstBinding + source.BindingCount; ++i) {
+            auto &binding = m_BindingTable->Bindings[i];
+
+            if (binding.Target == INPUT_BINDING_TARGET_AXIS) {
+                auto &sum = m_AxisSums[binding.MapIndex];
+                auto &activeSources = m_AxisActiveSources[binding.MapIndex];
+
+                sum += (static_cast<double>(value) - previous) * binding.Scale;
+                activeSources += (value != 0.0f) - (previous != 0.0f);
+
+                // once every source is back at rest the sum is exactly zero, so rounding errors can't pile up
+                if (activeSources == 0) {
+                    sum = 0.0;
+                }
+
+                m_AxisValues[binding.MapIndex] = m_BindingTable->AxisSettings[binding.MapIndex].Apply(sum);
+
+                if (timestamp != 0) {
+                    m_AxisHistories[binding.MapIndex].Push(timestamp, m_AxisValues[binding.MapIndex]);
+                }
+            } else {
+                bool wasPressed = std::abs(previous) >= ButtonPressThreshold;
+                bool isPressed = std::abs(value) >= ButtonPressThreshold;
+
+                if (wasPressed != isPressed) {
+                    auto &pressCount = m_ButtonPressCounts[binding.MapIndex];
+                    pressCount = isPressed ? pressCount + 1 : pressCount - 1;
+
+                    SetButtonState(InputButtonId{binding.MapIndex}, pressCount > 0);
+
+                    if (timestamp != 0) {
+                        m_ButtonHistories[binding.MapIndex].Push(timestamp, pressCount > 0 ? 1.0 : 0.0);
+                    }
+                }
+            }
+        }
+    }
+
+    void InputSystem::TrackKeyState(InputKeyHandle key, bool state) {
+        if (g_BuiltinKeyTable.Contains(key)) {
+            uint32_t slot = g_BuiltinKeyTable.GetSlot(key);
+            uint64_t mask = uint64_t{1} << (slot & 63);
+
+            if (state) {
+                m_BuiltinKeyBits[slot >> 6] |= mask;
+            } else {
+                m_BuiltinKeyBits[slot >> 6] &= ~mask;
+            }
+
+            return;
+        }
+
+        auto it = std::lower_bound(m_OtherKeysDown.begin(), m_OtherKeysDown.end(), key);
+        bool isDown = it != m_OtherKeysDown.end() && *it == key;
+
+        if (state && !isDown) {
+            m_OtherKeysDown.insert(it, key);
+        } else if (!state && isDown) {
+            m_OtherKeysDown.erase(it);
+        }
+    }
+
+    bool InputSystem::IsKeyHeld(InputKeyHandle key) const {
+        if (g_BuiltinKeyTable.Contains(key)) {
+            uint32_t slot = g_BuiltinKeyTable.GetSlot(key);
+            return (m_BuiltinKeyBits[slot >> 6] >> (slot & 63)) & 1;
+        }
+
+        return std::binary_search(m_OtherKeysDown.begin(), m_OtherKeysDown.end(), key);
+    }
+
+    void InputSystem::TrackPointer(const InputEvent &event) {
+        if (event.Type == INPUT_EVENT_TYPE_MOUSE_POSITION) {
+            m_MousePosition = event.Pointer.GetPosition();
+            return;
+        }
+
+        if (event.Pointer.Finger < 0 || static_cast<size_t>(event.Pointer.Finger) >= m_Touches.size()) {
+            return;
+        }
+
+        auto &touch = m_Touches[event.Pointer.Finger];
+        touch.IsDown = event.Type != INPUT_EVENT_TYPE_TOUCH_UP;
+        touch.Position = event.Pointer.GetPosition();
     }
 
     bool InputSystem::InternalInputCallback(const InputEvent &event) {
+        AdoptPendingBindings(event.Timestamp);
+
+        uint32_t sourceHandle;
+        float value;
+
         if (event.Type == InputEventType::INPUT_EVENT_TYPE_KEY_STATE_CHANGE) {
-            auto kAxisBinding = m_AxisBindings.find(event.Key);
-            auto kButtonBinding = m_ButtonBindings.find(event.Key);
+            sourceHandle = event.Key.Handle;
+            value = event.Key.State ? 1.0f : 0.0f;
 
-            if (kAxisBinding != m_AxisBindings.end()) {
-                m_AxisState[kAxisBinding->second.Mapping] = event.KeyState ? kAxisBinding->second.Scale : 0.0f;
-                g_LoggerInputSystem.Log(runtime::LOG_LEVEL_DEBUG, "Key Input Axis %x: %f", kAxisBinding->second.Mapping,
-                                        m_AxisState[kAxisBinding->second.Mapping]);
+            TrackKeyState(event.Key.Handle, event.Key.State);
 
-                return true;
-            } else if (kButtonBinding != m_ButtonBindings.end()) {
-                m_ButtonState[kButtonBinding->second] = event.KeyState;
-                g_LoggerInputSystem.Log(runtime::LOG_LEVEL_DEBUG, "Key Input Button %x: %s", kButtonBinding->second,
-                                        m_ButtonState[kButtonBinding->second] ? "DOWN" : "UP");
+            // combos see every key, bound or not
+            m_MatchedCombos.clear();
+            m_BindingTable->ComboMatcher.Advance(m_ComboState, event.Key.Handle, event.Key.State, event.Timestamp,
+                                                 m_MatchedCombos);
 
-                return true;
+            for (auto combo: m_MatchedCombos) {
+                m_ComboTriggeredBits[combo >> 6] |= uint64_t{1} << (combo & 63);
             }
         } else if (event.Type == InputEventType::INPUT_EVENT_TYPE_AXIS_CHANGE) {
-            auto axisBinding = m_AxisBindings.find(event.Axis);
+            sourceHandle = event.Axis.Handle;
+            value = event.Axis.Value;
+        } else {
+            // pointers aren't bound to anything, they're only tracked for the snapshots
+            TrackPointer(event);
+            return false;
+        }
 
-            if (axisBinding != m_AxisBindings.end()) {
-                m_AxisState[axisBinding->second.Mapping] = event.AxisValue * axisBinding->second.Scale;
-                g_LoggerInputSystem.Log(runtime::LOG_LEVEL_DEBUG, "Input Axis %x: %f", axisBinding->second.Mapping,
-                                        m_AxisState[axisBinding->second.Mapping]);
+        auto sourceIndex = m_BindingTable->FindSource(sourceHandle);
 
-                return true;
-            }
+        if (sourceIndex == InputBindingTable::NoSource) {
+            return false;
         }
 
-        return false;
+        UpdateSource(sourceIndex, value, event.Timestamp);
+        InputTrace::Write<INPUT_TRACE_LEVEL_VERBOSE>(INPUT_TRACE_EVENT_SOURCE_UPDATED, sourceHandle,
+                                                     InputTrace::FloatArg(value));
+
+        return true;
     }
 
     void InputSystem::Update() {
-        // ToDo: implement event publishing
+        // bindings published while no input arrived still take effect once per frame
+        uint64_t now = InputClock::Now();
+        AdoptPendingBindings(now);
+
+        // the buffer being filled is two frames older than the current snapshot, so no reader is supposed to hold
+        // it anymore. assign() reuses the capacity, so this doesn't allocate once the sizes have settled.
+        auto &previous = *m_CurrentSnapshot.load(std::memory_order_relaxed);
+        auto &snapshot = m_Snapshots[++m_Frame % SnapshotBufferCount];
+
+        snapshot.Frame = m_Frame;
+        snapshot.Timestamp = now;
+        snapshot.Bindings = m_BindingTable;
+        snapshot.AxisValues.assign(m_AxisValues.begin(), m_AxisValues.end());
+        snapshot.ButtonBits.assign(m_ButtonBits.begin(), m_ButtonBits.end());
+        snapshot.ComboTriggeredBits.assign(m_ComboTriggeredBits.begin(), m_ComboTriggeredBits.end());
+        std::fill(m_ComboTriggeredBits.begin(), m_ComboTriggeredBits.end(), 0);
+        snapshot.BuiltinKeyBits = m_BuiltinKeyBits;
+        snapshot.OtherKeysDown.assign(m_OtherKeysDown.begin(), m_OtherKeysDown.end());
+        snapshot.MousePosition = m_MousePosition;
+        snapshot.Touches = m_Touches;
+
+        // edges are derived once here rather than by every caller of GetButtonDown and friends
+        snapshot.DiffWith(previous);
+
+        m_CurrentSnapshot.store(&snapshot, std::memory_order_release);
     }
 
     void InputSystem::BindAxis(std::string_view mapName, std::string_view axisOrKeyName, double scaleValue) {
-        m_AxisBindings[FNVConstHash(axisOrKeyName)] = {FNVConstHash(mapName), scaleValue};
+        mtx_Bindings->Lock();
+        m_BindingSet.AddAxis(FNVConstHash(mapName), FNVConstHash(axisOrKeyName), static_cast<float>(scaleValue));
+        PublishBindings();
+        mtx_Bindings->Unlock();
     }
 
     void InputSystem::UnbindAxis(std::string_view mapName, std::string_view axisOrKeyName) {
-        // ToDo: implement
+        mtx_Bindings->Lock();
+
+        // the mapping keeps its id, it just stops receiving input from this source
+        if (m_BindingSet.Remove(FNVConstHash(mapName), FNVConstHash(axisOrKeyName), INPUT_BINDING_TARGET_AXIS)) {
+            PublishBindings();
+        }
+
+        mtx_Bindings->Unlock();
+    }
+
+    void InputSystem::SetAxisSettings(std::string_view mapName, const InputAxisSettings &settings) {
+        mtx_Bindings->Lock();
+        m_BindingSet.SetAxisSettings(FNVConstHash(mapName), settings);
+        PublishBindings();
+        mtx_Bindings->Unlock();
+    }
+
+    void InputSystem::SetBindings(InputBindingSet bindings) {
+        mtx_Bindings->Lock();
+        m_BindingSet = std::move(bindings);
+        PublishBindings();
+        mtx_Bindings->Unlock();
+    }
+
+    InputBindingSet InputSystem::GetBindings() const {
+        mtx_Bindings->Lock();
+        auto bindings = m_BindingSet;
+        mtx_Bindings->Unlock();
+
+        return bindings;
     }
 
     void InputSystem::BindButton(std::string_view mapName, std::string_view keyName) {
-        m_ButtonBindings[FNVConstHash(keyName)] = FNVConstHash(mapName);
+        mtx_Bindings->Lock();
+        m_BindingSet.AddButton(FNVConstHash(mapName), FNVConstHash(keyName));
+        PublishBindings();
+        mtx_Bindings->Unlock();
     }
 
     void InputSystem::UnbindButton(std::string_view mapName, std::string_view keyName) {
-        // ToDo: implement
+        mtx_Bindings->Lock();
+
+        if (m_BindingSet.Remove(FNVConstHash(mapName), FNVConstHash(keyName), INPUT_BINDING_TARGET_BUTTON)) {
+            PublishBindings();
+        }
+
+        mtx_Bindings->Unlock();
+    }
+
+    void InputSystem::BindCombo(std::string_view mapName, std::string_view steps, uint32_t windowMilliseconds) {
+        std::vector<InputComboStep> comboSteps;
+
+        if (!InputBindingConfig::ParseComboSteps(steps, comboSteps)) {
+            g_LoggerInputSystem.Log(runtime::LOG_LEVEL_WARNING, "Combo '%.*s' has no steps; ignoring.",
+                                    static_cast<int>(mapName.size()), mapName.data());
+            return;
+        }
+
+        mtx_Bindings->Lock();
+        m_BindingSet.AddCombo(FNVConstHash(mapName), std::move(comboSteps), windowMilliseconds * 1000000ull);
+        PublishBindings();
+        mtx_Bindings->Unlock();
+    }
+
+    void InputSystem::UnbindCombo(std::string_view mapName) {
+        mtx_Bindings->Lock();
+
+        if (m_BindingSet.RemoveCombos(FNVConstHash(mapName))) {
+            PublishBindings();
+        }
+
+        mtx_Bindings->Unlock();
     }
 }
\ No newline at end of file
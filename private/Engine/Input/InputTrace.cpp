@@ -0,0 +1,178 @@
+#include <Engine/Input/InputTrace.hpp>
+#include <Engine/Input/InputMappedFile.hpp>
+
+#include <atomic>
+#include <cinttypes>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace engine::input {
+    struct InputTraceFileHeader {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t RecordSize;
+        uint32_t RingCount;
+    };
+
+    // precedes the records of every ring in a dump
+    struct InputTraceFileRing {
+        uint32_t ThreadIndex;
+        uint32_t RecordCount;
+    };
+
+    static_assert(sizeof(InputTraceFileHeader) == 16, "trace file header layout has changed");
+    static_assert(sizeof(InputTraceFileRing) == 8, "trace file ring layout has changed");
+
+    // written by its own thread only; the position is atomic so that Dump sees complete records.
+    struct InputTraceRing {
+        uint32_t ThreadIndex;
+        std::atomic<uint64_t> WritePos{0};
+        InputTraceRecord Records[InputTrace::RingCapacity];
+    };
+
+    // rings are never freed, so that a dump still contains the records of threads that have exited
+    static std::mutex g_TraceRingsLock;
+    static std::vector<std::unique_ptr<InputTraceRing>> g_TraceRings;
+
+    static thread_local InputTraceRing *g_ThreadTraceRing;
+
+    static InputTraceRing *CreateTraceRing() {
+        std::lock_guard lock(g_TraceRingsLock);
+
+        auto &ring = g_TraceRings.emplace_back(std::make_unique<InputTraceRing>());
+        ring->ThreadIndex = static_cast<uint32_t>(g_TraceRings.size() - 1);
+
+        return ring.get();
+    }
+
+    void InputTrace::Append(const InputTraceRecord &record) {
+        auto ring = g_ThreadTraceRing;
+
+        if (!ring) {
+            ring = g_ThreadTraceRing = CreateTraceRing();
+        }
+
+        auto pos = ring->WritePos.load(std::memory_order_relaxed);
+
+        ring->Records[pos % RingCapacity] = record;
+        ring->WritePos.store(pos + 1, std::memory_order_release);
+    }
+
+    bool InputTrace::Dump(const std::filesystem::path &path) {
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+
+        if (!stream) {
+            return false;
+        }
+
+        std::lock_guard lock(g_TraceRingsLock);
+
+        InputTraceFileHeader header{FileMagic, FileVersion, sizeof(InputTraceRecord),
+                                    static_cast<uint32_t>(g_TraceRings.size())};
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        for (auto &ring: g_TraceRings) {
+            auto end = ring->WritePos.load(std::memory_order_acquire);
+            auto begin = end > RingCapacity ? end - RingCapacity : 0;
+
+            InputTraceFileRing ringHeader{ring->ThreadIndex, static_cast<uint32_t>(end - begin)};
+            stream.write(reinterpret_cast<const char *>(&ringHeader), sizeof(ringHeader));
+
+            for (auto pos = begin; pos < end; ++pos) {
+                stream.write(reinterpret_cast<const char *>(&ring->Records[pos % RingCapacity]),
+                             sizeof(InputTraceRecord));
+            }
+        }
+
+        return static_cast<bool>(stream);
+    }
+
+    static void PrintTraceArg(std::FILE *out, std::string_view name, InputTraceArgKind kind, uint64_t value) {
+        if (kind == INPUT_TRACE_ARG_NONE) {
+            return;
+        }
+
+        std::fprintf(out, " %.*s=", static_cast<int>(name.size()), name.data());
+
+        switch (kind) {
+            case INPUT_TRACE_ARG_UINT:
+                std::fprintf(out, "%" PRIu64, value);
+                break;
+            case INPUT_TRACE_ARG_HEX:
+                std::fprintf(out, "0x%08" PRIx64, value);
+                break;
+            case INPUT_TRACE_ARG_FLOAT:
+                std::fprintf(out, "%f", std::bit_cast<float>(static_cast<uint32_t>(value)));
+                break;
+            case INPUT_TRACE_ARG_EVENT_TYPE:
+                std::fprintf(out, "%u", static_cast<unsigned>(value));
+                break;
+            case INPUT_TRACE_ARG_POSITION:
+                std::fprintf(out, "%fx%f", std::bit_cast<float>(static_cast<uint32_t>(value)),
+                             std::bit_cast<float>(static_cast<uint32_t>(value >> 32)));
+                break;
+            default:
+                break;
+        }
+    }
+
+    bool InputTrace::Decode(const std::filesystem::path &path, std::FILE *out) {
+        static constexpr const char *levelNames[] = {"OFF", "ERROR", "WARNING", "INFO", "DEBUG", "VERBOSE"};
+
+        InputMappedFile file;
+
+        if (!file.Open(path) || file.GetSize() < sizeof(InputTraceFileHeader)) {
+            return false;
+        }
+
+        InputTraceFileHeader header;
+        std::memcpy(&header, file.GetData(), sizeof(header));
+
+        if (header.Magic != FileMagic || header.Version != FileVersion ||
+            header.RecordSize != sizeof(InputTraceRecord)) {
+            return false;
+        }
+
+        const uint8_t *cursor = file.GetData() + sizeof(header);
+        const uint8_t *end = file.GetData() + file.GetSize();
+
+        for (uint32_t i = 0; i < header.RingCount; ++i) {
+            InputTraceFileRing ring;
+
+            if (static_cast<size_t>(end - cursor) < sizeof(ring)) {
+                return false;
+            }
+
+            std::memcpy(&ring, cursor, sizeof(ring));
+            cursor += sizeof(ring);
+
+            if (static_cast<size_t>(end - cursor) < static_cast<size_t>(ring.RecordCount) * sizeof(InputTraceRecord)) {
+                return false;
+            }
+
+            for (uint32_t j = 0; j < ring.RecordCount; ++j, cursor += sizeof(InputTraceRecord)) {
+                InputTraceRecord record;
+                std::memcpy(&record, cursor, sizeof(record));
+
+                if (record.Event >= INPUT_TRACE_EVENT_COUNT || record.Level > INPUT_TRACE_LEVEL_VERBOSE) {
+                    std::fprintf(out, "%" PRIu64 " [thread %u] <invalid record>\n", record.Timestamp,
+                                 ring.ThreadIndex);
+                    continue;
+                }
+
+                auto &info = g_InputTraceEventInfo[record.Event];
+
+                std::fprintf(out, "%" PRIu64 " [thread %u] %s %.*s", record.Timestamp, ring.ThreadIndex,
+                             levelNames[record.Level], static_cast<int>(info.Name.size()), info.Name.data());
+                PrintTraceArg(out, info.Arg0Name, info.Arg0Kind, record.Arg0);
+                PrintTraceArg(out, info.Arg1Name, info.Arg1Kind, record.Arg1);
+                std::fputc('\n', out);
+            }
+        }
+
+        return true;
+    }
+}
@@ -3,6 +3,11 @@
 #include <string>
 
 namespace engine::input {
+    // Native handle that becomes readable when a device has pending input (a file descriptor on POSIX platforms).
+    using InputWaitHandle = int;
+
+    constexpr InputWaitHandle INPUT_WAIT_HANDLE_INVALID = -1;
+
     struct IInputDevice {
         virtual ~IInputDevice() = default;
 
@@ -13,5 +18,11 @@ namespace engine::input {
         virtual std::string GetName() const = 0;
 
         virtual int GetPlayerId() = 0;
+
+        // devices that can be waited on are only polled when their handle signals pending input; the others are
+        // polled at the fixed rate configured through InputManager::SetPollInterval.
+        virtual InputWaitHandle GetWaitHandle() {
+            return INPUT_WAIT_HANDLE_INVALID;
+        }
     };
 }
\ No newline at end of file
@@ -25,6 +25,12 @@ namespace engine::input {
 
         virtual bool IsPointOnKeyboard(const core::math::Vector2& point) = 0;
 
+        // keyboards covering a rectangle report it here, so that whole batches of touches can be tested against it
+        // at once; the others are asked through IsPointOnKeyboard for every touch.
+        virtual bool GetKeyboardBounds(core::math::Vector2& /*min*/, core::math::Vector2& /*max*/) {
+            return false;
+        }
+
         // specify input targets that must be ignored while the virtual input device is shown
         virtual InputIgnoreTarget GetInputIgnoreTarget() const = 0;
     };
@@ -1,22 +1,25 @@
 #pragma once
 
-#include <unordered_map>
-#include <string>
 #include <string_view>
+#include <cstdint>
+
+#include <Engine/Input/InputNameRegistry.hpp>
 
 namespace engine::input {
     // The Input Axis Handle represents the hashed name identifier of an axis.
     using InputAxisHandle = uint32_t;
 
+    // Lookups are lock-free and safe from any thread, including while other threads register axes.
     struct InputAxisRepository {
         virtual ~InputAxisRepository() = default;
 
         static InputAxisRepository& Instance();
 
-        std::string GetAxisName(InputAxisHandle handle);
-        bool HasAxis(InputAxisHandle handle);
+        // returns a null-terminated view valid for the lifetime of the repository, or an empty view for unknown axes.
+        std::string_view GetAxisName(InputAxisHandle handle) const;
+        bool HasAxis(InputAxisHandle handle) const;
         InputAxisHandle AddAxis(std::string_view axisName);
     protected:
-        std::unordered_map<InputAxisHandle, std::string> m_AxisList;
+        InputNameRegistry m_AxisList;
     };
 }
\ No newline at end of file
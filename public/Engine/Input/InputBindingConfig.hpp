@@ -0,0 +1,46 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include <Engine/Input/InputBindingTable.hpp>
+
+namespace engine::input {
+    // Loads bindings from the Input.ini format:
+    //
+    //   [InputSystem.AxisMapping]
+    //   MoveForward=Key_W,1.0|Key_S,-1.0
+    //   [InputSystem.ButtonMapping]
+    //   Jump=Key_Space|NX_JoyCon_A
+    //   [InputSystem.ComboMapping]
+    //   Hadouken=Key_ArrowDown Key_ArrowDown+Key_ArrowRight Key_ArrowRight+Key_A,200
+    //   Palette=Key_LeftCtrl+Key_LeftShift+Key_P
+    //
+    // Combo steps are separated by spaces and the keys of a chord by '+'; the optional number is the time window in
+    // milliseconds.
+    // Names are hashed straight from the text, so parsing never allocates strings. A parsed config is also written
+    // to a binary cache which later starts memory-map instead of parsing, as long as the config file is unchanged.
+    struct InputBindingConfig {
+        static constexpr uint32_t CacheMagic = 0x43424952; // "RIBC"
+        static constexpr uint32_t CacheVersion = 2;
+
+        // parses config text into "out" and returns the number of bindings read; malformed entries are skipped.
+        static size_t Parse(std::string_view text, InputBindingSet &out);
+
+        // parses the steps of a combo, e.g. "Key_ArrowDown Key_ArrowDown+Key_ArrowRight"; false if it has none
+        static bool ParseComboSteps(std::string_view text, std::vector<InputComboStep> &steps);
+
+        // uses the cache when it matches the config file, otherwise parses the config and refreshes the cache.
+        static bool Load(const std::filesystem::path &configPath, const std::filesystem::path &cachePath,
+                         InputBindingSet &out);
+
+        static bool ReadCache(const std::filesystem::path &cachePath, const std::filesystem::path &configPath,
+                              InputBindingSet &out);
+
+        static bool WriteCache(const std::filesystem::path &cachePath, const std::filesystem::path &configPath,
+                               const InputBindingSet &set);
+    };
+}
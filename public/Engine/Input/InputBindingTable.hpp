@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+#include <Engine/Input/InputKeyRepository.hpp>
+#include <Engine/Input/InputAxisRepository.hpp>
+#include <Engine/Input/InputComboMatcher.hpp>
+
+namespace engine::input {
+    // The Input Map Handle represents the hashed name identifier of an axis or button mapping.
+    using InputMapHandle = uint32_t;
+
+    // Dense indices of mappings, resolved once through InputSystem::GetAxisId / GetButtonId and stable for the
+    // lifetime of the input system. Index 0 is reserved for unknown mappings and always reads as zero / released, so
+    // queries through an id are a single indexed load.
+    struct InputAxisId {
+        uint32_t Index{0};
+
+        bool IsValid() const {
+            return Index != 0;
+        }
+    };
+
+    struct InputButtonId {
+        uint32_t Index{0};
+
+        bool IsValid() const {
+            return Index != 0;
+        }
+    };
+
+    struct InputComboId {
+        uint32_t Index{0};
+
+        bool IsValid() const {
+            return Index != 0;
+        }
+    };
+
+    enum InputBindingTarget : uint8_t {
+        INPUT_BINDING_TARGET_AXIS,
+        INPUT_BINDING_TARGET_BUTTON
+    };
+
+    // Output shaping of an axis mapping, applied to the sum of all of its sources.
+    struct InputAxisSettings {
+        // sums whose magnitude is below the dead zone read as zero
+        float DeadZone{0.0f};
+        float Min{-1.0f};
+        float Max{1.0f};
+
+        double Apply(double value) const {
+            return std::abs(value) < DeadZone ? 0.0 : std::clamp(value, static_cast<double>(Min),
+                                                                 static_cast<double>(Max));
+        }
+    };
+
+    // A single declared binding: a key or axis (the source) feeding a mapping.
+    struct InputBindingDesc {
+        InputMapHandle Mapping;
+        // key or axis handle
+        uint32_t Source;
+        InputBindingTarget Target;
+        // only used by axis mappings
+        float Scale;
+    };
+
+    // A key sequence or chord triggering a combo mapping; see InputComboMatcher. A mapping may have several of them,
+    // e.g. one per controller layout.
+    struct InputComboDesc {
+        InputMapHandle Mapping;
+        std::vector<InputComboStep> Steps;
+        // maximum time from the first step to the last, in nanoseconds; 0 for no limit
+        uint64_t Window;
+    };
+
+    struct InputBindingTable;
+
+    // Declarative list of bindings, as written by BindAxis / BindButton or loaded from the config. Any number of
+    // sources may feed a mapping and any source may feed any number of mappings.
+    struct InputBindingSet {
+        // binding the same source to the same mapping again only updates its scale
+        void AddAxis(InputMapHandle mapping, uint32_t source, float scale);
+
+        void AddButton(InputMapHandle mapping, uint32_t source);
+
+        // returns false if there was no such binding
+        bool Remove(InputMapHandle mapping, uint32_t source, InputBindingTarget target);
+
+        void SetAxisSettings(InputMapHandle mapping, const InputAxisSettings &settings);
+
+        // declaring the same steps for the same mapping again only updates the window
+        void AddCombo(InputMapHandle mapping, std::vector<InputComboStep> steps, uint64_t window);
+
+        // removes every combo of the mapping, returns false if it had none
+        bool RemoveCombos(InputMapHandle mapping);
+
+        // ids assigned by "previous" are kept, so that ids resolved against it remain valid.
+        std::shared_ptr<const InputBindingTable> Compile(const InputBindingTable *previous = nullptr) const;
+
+        std::vector<InputBindingDesc> Bindings;
+        std::unordered_map<InputMapHandle, InputAxisSettings> AxisSettings;
+        std::vector<InputComboDesc> Combos;
+    };
+
+    // Compiled, immutable form of a binding set: every source maps to a contiguous run of bindings, and every mapping
+    // owns a dense id indexing the input system's state arrays.
+    struct InputBindingTable {
+        static constexpr uint32_t NoSource = UINT32_MAX;
+
+        struct Binding {
+            uint32_t MapIndex;
+            InputBindingTarget Target;
+            float Scale;
+        };
+
+        struct Source {
+            uint32_t Handle;
+            uint32_t FirstBinding;
+            uint32_t BindingCount;
+        };
+
+        uint32_t FindSource(uint32_t handle) const {
+            auto it = SourceIndices.find(handle);
+            return it != SourceIndices.end() ? it->second : NoSource;
+        }
+
+        InputAxisId FindAxis(InputMapHandle mapping) const {
+            auto it = AxisIds.find(mapping);
+            return it != AxisIds.end() ? it->second : InputAxisId{};
+        }
+
+        InputButtonId FindButton(InputMapHandle mapping) const {
+            auto it = ButtonIds.find(mapping);
+            return it != ButtonIds.end() ? it->second : InputButtonId{};
+        }
+
+        InputComboId FindCombo(InputMapHandle mapping) const {
+            auto it = ComboIds.find(mapping);
+            return it != ComboIds.end() ? it->second : InputComboId{};
+        }
+
+        uint32_t GetAxisCount() const {
+            return static_cast<uint32_t>(AxisSettings.size());
+        }
+
+        std::unordered_map<uint32_t, uint32_t> SourceIndices;
+        std::vector<Source> Sources;
+        std::vector<Binding> Bindings;
+
+        std::unordered_map<InputMapHandle, InputAxisId> AxisIds;
+        std::unordered_map<InputMapHandle, InputButtonId> ButtonIds;
+
+        // indexed by axis id; entry 0 belongs to the unknown mapping slot
+        std::vector<InputAxisSettings> AxisSettings{1};
+        uint32_t ButtonCount{1};
+
+        std::unordered_map<InputMapHandle, InputComboId> ComboIds;
+        uint32_t ComboCount{1};
+        // reports combo ids
+        InputComboMatcher ComboMatcher;
+    };
+}
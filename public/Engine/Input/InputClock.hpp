@@ -0,0 +1,14 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace engine::input {
+    // Monotonic clock used to stamp input events, in nanoseconds.
+    struct InputClock {
+        static uint64_t Now() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+    };
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include <Engine/Input/InputKeyRepository.hpp>
+
+namespace engine::input {
+    // Keys of one step of a combo. A step of several keys is a chord: it is completed by the press that leaves all of
+    // them held, in whatever order they went down.
+    using InputComboStep = std::vector<InputKeyHandle>;
+
+    // Recognizes key sequences and chords, e.g. "Down, Down+Right, Right+A within 200 ms" or "Ctrl+Shift+K", with a
+    // single automaton shared by every combo.
+    //
+    // Every distinct step is a symbol. A key press is read as the most specific step it completes, and the symbols
+    // drive a DFA built with Aho-Corasick over the combos' step sequences, flattened into a dense transition table:
+    // each press costs one hash lookup, a scan of the few steps containing the key and one table load, however many
+    // combos there are. Presses of keys no combo uses are ignored. A press completing no step leaves the sequences in
+    // progress waiting for the rest of its chord; they break once the keys pressed since the last step are part of no
+    // single step, or one of them is released first.
+    struct InputComboMatcher {
+        // keys taking part in combos; combos needing more are left out
+        static constexpr size_t MaxKeys = 256;
+
+        using KeyMask = std::array<uint64_t, MaxKeys / 64>;
+
+        struct Pattern {
+            uint32_t Id;
+            std::vector<InputComboStep> Steps;
+            // maximum time between the presses completing the first and the last step, in nanoseconds; 0 for none
+            uint64_t Window;
+        };
+
+        // Per-instance progress, kept by the caller so that a matcher can be shared. Reset it whenever it is used
+        // with a different matcher.
+        struct State {
+            uint32_t Node{0};
+            KeyMask Held{};
+            // keys pressed since the last completed step, i.e. a chord being put together
+            KeyMask Pending{};
+            // times of the last symbols, a ring of GetMaxLength entries
+            std::vector<uint64_t> StepTimes;
+            uint64_t StepCount{0};
+        };
+
+        static InputComboMatcher Compile(const std::vector<Pattern> &patterns);
+
+        bool IsEmpty() const {
+            return m_Outputs.empty();
+        }
+
+        // keys taking part in combos, by bit index
+        const std::vector<InputKeyHandle> &GetKeys() const {
+            return m_Keys;
+        }
+
+        void Reset(State &state) const;
+
+        // marks a key as held without completing anything, e.g. for keys already down when the state was reset
+        void SetHeld(State &state, InputKeyHandle key) const;
+
+        // feeds a key change and appends the id of every combo it completes to "matched"
+        void Advance(State &state, InputKeyHandle key, bool pressed, uint64_t timestamp,
+                     std::vector<uint32_t> &matched) const;
+
+    protected:
+        struct Step {
+            KeyMask Keys;
+            uint32_t KeyCount;
+        };
+
+        struct Output {
+            uint32_t Id;
+            uint32_t Length;
+            uint64_t Window;
+        };
+
+        static bool Contains(const KeyMask &held, const KeyMask &keys) {
+            uint64_t missing = 0;
+
+            for (size_t i = 0; i < held.size(); ++i) {
+                missing |= keys[i] & ~held[i];
+            }
+
+            return missing == 0;
+        }
+
+        std::vector<InputKeyHandle> m_Keys;
+        std::unordered_map<InputKeyHandle, uint32_t> m_KeyIndices;
+
+        std::vector<Step> m_Steps;
+        // indexed by key bit: the steps containing the key, most keys first
+        std::vector<uint32_t> m_KeyStepStarts{0};
+        std::vector<uint32_t> m_KeySteps;
+
+        // m_Steps.size() entries per state, state 0 being the root
+        std::vector<uint32_t> m_Transitions;
+        // combos completed on entering a state, including the ones ending in a suffix of its sequence
+        std::vector<uint32_t> m_OutputStarts{0, 0};
+        std::vector<Output> m_Outputs;
+        uint32_t m_MaxLength{0};
+    };
+}
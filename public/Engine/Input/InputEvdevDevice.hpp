@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include <Engine/Input/IInputDevice.hpp>
+#include <Engine/Input/InputKeyRepository.hpp>
+#include <Engine/Input/InputAxisRepository.hpp>
+
+namespace engine::input {
+    struct InputManager;
+
+    // Linux evdev device (/dev/input/event*): keyboards, mice and gamepads without any windowing layer in between.
+    // Every Poll drains the device with as few read() calls as possible, BatchSize events at a time, and translates
+    // them through a compile-time table indexed by event code. Keys and buttons are pushed as key changes, relative
+    // and absolute axes as axis changes; absolute axes are normalized to [-1, 1] (sticks) or [0, 1] (triggers).
+    // The device also works on any other readable stream of "struct input_event", such as a pipe or a file captured
+    // from a real device, which is how it is exercised without hardware. Multi-touch (ABS_MT_*) isn't translated.
+    // Elsewhere than on Linux, Initialize always fails.
+    struct InputEvdevDevice : IInputDevice {
+        // events fetched by a single read()
+        static constexpr size_t BatchSize = 64;
+
+        explicit InputEvdevDevice(std::filesystem::path path, int playerId = -1);
+
+        // adopts an already open descriptor, e.g. the read end of a pipe; it is closed by Destroy
+        InputEvdevDevice(int fd, std::string name, int playerId = -1);
+
+        ~InputEvdevDevice() override;
+
+        bool Initialize() override;
+
+        void Destroy() override;
+
+        void Poll() override;
+
+        std::string GetName() const override;
+
+        int GetPlayerId() override;
+
+        InputWaitHandle GetWaitHandle() override;
+
+        // pushes into the given manager rather than the global one
+        void SetManager(InputManager *manager) {
+            m_Manager = manager;
+        }
+
+        // overrides the range of an absolute axis, for streams that can't be queried (pipes, captures)
+        void SetAbsoluteRange(uint16_t code, int32_t minimum, int32_t maximum);
+
+        // set once the device went away (ENODEV) or the stream ended; Poll does nothing from then on and its handle
+        // is no longer waited on. safe to check from any thread.
+        bool IsDisconnected() const {
+            return b_Disconnected;
+        }
+
+        // event*, sorted by number
+        static std::vector<std::filesystem::path> FindDevices(const std::filesystem::path &directory = "/dev/input");
+
+    protected:
+        struct AbsoluteRange {
+            int32_t Minimum{0};
+            int32_t Maximum{0};
+        };
+
+        void ProcessEvents(const uint8_t *data, size_t count);
+
+        void PushKey(uint16_t code, bool state, uint64_t timestamp);
+
+        // pushes the key changes missed while events were dropped; only possible on real evdev devices
+        void ResyncKeys(uint64_t timestamp);
+
+        // same for the absolute axes the translation table knows
+        void ResyncAbsoluteAxes(uint64_t timestamp);
+
+        void PushAbsolute(uint16_t code, int32_t value, uint64_t timestamp);
+
+        float NormalizeAbsolute(uint16_t code, int32_t value) const;
+
+        std::filesystem::path m_Path;
+        std::string m_Name;
+        int m_PlayerId;
+        int m_Fd{-1};
+        // set if the descriptor was handed to the constructor
+        bool b_AdoptedFd{false};
+        InputManager *m_Manager{nullptr};
+
+        // timestamps are only passed on as hardware timestamps once the kernel was switched to CLOCK_MONOTONIC,
+        // which is the clock InputClock reads
+        bool b_MonotonicTimestamps{false};
+        // after SYN_DROPPED every event is discarded up to the next SYN_REPORT
+        bool b_Dropping{false};
+        // read by the owner, which is expected to unregister the device once it's lost
+        std::atomic<bool> b_Disconnected{false};
+
+        // raw read buffer; a pipe may hand over a partial event, which is kept until the rest arrives
+        std::vector<uint8_t> m_ReadBuffer;
+        size_t m_PendingBytes{0};
+
+        // keys held as far as the pushed events go, by KEY_* code; compared against the kernel's state to recover
+        // from SYN_DROPPED
+        std::array<uint64_t, 12> m_KeyBits{};
+
+        // indexed by ABS_* code; ranges of the axes the translation table knows, a zero range means unknown
+        std::array<AbsoluteRange, 64> m_AbsoluteRanges{};
+        // last value pushed for each ABS_* code, valid for the codes set in m_AbsoluteKnown
+        std::array<int32_t, 64> m_AbsoluteValues{};
+        uint64_t m_AbsoluteKnown{0};
+        // REL_* codes that moved in the current report and in the previous one; relative axes are reset to 0 once
+        // a report comes without motion for them
+        uint32_t m_RelativeMoved{0};
+        uint32_t m_RelativeActive{0};
+    };
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
+#include <type_traits>
 
 #include <Engine/Core/Math/Vector2.hpp>
 
@@ -8,7 +10,7 @@
 #include <Engine/Input/InputAxisRepository.hpp>
 
 namespace engine::input {
-    enum InputEventType {
+    enum InputEventType : uint8_t {
         INPUT_EVENT_TYPE_UNKNOWN,
 
         INPUT_EVENT_TYPE_MOUSE_POSITION,
@@ -19,39 +21,112 @@ namespace engine::input {
         INPUT_EVENT_TYPE_TOUCH_DOWN,
         INPUT_EVENT_TYPE_TOUCH_UP,
         INPUT_EVENT_TYPE_TOUCH_MOVE,
-        INPUT_EVENT_TYPE_TOUCH_HOVER
+        INPUT_EVENT_TYPE_TOUCH_HOVER,
+
+        INPUT_EVENT_TYPE_COUNT
+    };
+
+    enum InputEventFlags : uint8_t {
+        INPUT_EVENT_FLAG_NONE = 0,
+        // a later sample of the same pointer, finger or axis in the same batch makes this one redundant; only
+        // listeners that asked for every sample receive it.
+        INPUT_EVENT_FLAG_SUPERSEDED = 1 << 0,
+        // rejected by one of the manager's event filters; never dispatched
+        INPUT_EVENT_FLAG_FILTERED = 1 << 1
+    };
+
+    // device id of events that weren't pushed from within a device's Poll()
+    constexpr uint8_t INPUT_DEVICE_ID_NONE = 0;
+    // player id of events whose device isn't assigned to a player
+    constexpr uint8_t INPUT_PLAYER_ID_NONE = 0xFF;
+
+    // payload of INPUT_EVENT_TYPE_KEY_STATE_CHANGE
+    struct InputKeyEventData {
+        InputKeyHandle Handle;
+        bool State;
     };
 
-    // ToDo: improve storage size by using unions
+    // payload of INPUT_EVENT_TYPE_AXIS_CHANGE
+    struct InputAxisEventData {
+        InputAxisHandle Handle;
+        float Value;
+    };
+
+    // payload of INPUT_EVENT_TYPE_INPUT_CHAR
+    struct InputCharEventData {
+        uint16_t Code;
+    };
+
+    // payload of INPUT_EVENT_TYPE_MOUSE_POSITION and the touch events; the mouse always uses finger 0.
+    struct InputPointerEventData {
+        int32_t Finger;
+        float X;
+        float Y;
+
+        core::math::Vector2 GetPosition() const {
+            return {X, Y};
+        }
+    };
+
+    // Events are copied through the event queue and every delegate, so they are kept trivially copyable and small:
+    // a one byte type tag followed by a union holding the payload of the active event type and the timestamps.
     struct InputEvent {
-        InputEvent(InputEventType type) : Type(type), AxisValue(0.0f) {}
+        InputEvent() = default;
+
+        InputEvent(InputEventType type) : Type(type) {}
+
+        static InputEvent MakeKeyStateChange(InputKeyHandle key, bool state) {
+            InputEvent event{INPUT_EVENT_TYPE_KEY_STATE_CHANGE};
+            event.Key = {key, state};
+            return event;
+        }
 
-        ~InputEvent() = default;
+        static InputEvent MakeAxisChange(InputAxisHandle axis, float value) {
+            InputEvent event{INPUT_EVENT_TYPE_AXIS_CHANGE};
+            event.Axis = {axis, value};
+            return event;
+        }
 
-        InputEvent(const InputEvent &other) {
-            Type = other.Type;
+        static InputEvent MakeInputChar(uint16_t ch) {
+            InputEvent event{INPUT_EVENT_TYPE_INPUT_CHAR};
+            event.Char = {ch};
+            return event;
+        }
 
-            Key = other.Key;
-            Axis = other.Axis;
+        static InputEvent MakePointer(InputEventType type, int32_t finger, const core::math::Vector2 &position) {
+            InputEvent event{type};
+            event.Pointer = {finger, position.x, position.y};
+            return event;
+        }
 
-            KeyState = other.KeyState;
-            UInputChar = other.UInputChar;
-            TouchFinger = other.TouchFinger;
-            AxisValue = other.AxisValue;
-            Position = other.Position;
+        static bool IsOlderThan(const InputEvent &a, const InputEvent &b) {
+            return a.Timestamp < b.Timestamp;
         }
 
-        InputEventType Type;
+        InputEventType Type{INPUT_EVENT_TYPE_UNKNOWN};
+        uint8_t Flags{INPUT_EVENT_FLAG_NONE};
+        // registration slot of the device that pushed the event and the player it was assigned to at the time
+        uint8_t Device{INPUT_DEVICE_ID_NONE};
+        uint8_t Player{INPUT_PLAYER_ID_NONE};
 
         union {
-            InputKeyHandle Key;
-            InputAxisHandle Axis;
+            InputKeyEventData Key{};
+            InputAxisEventData Axis;
+            InputCharEventData Char;
+            InputPointerEventData Pointer;
         };
 
-        bool KeyState;
-        uint16_t UInputChar;
-        int TouchFinger;
-        float AxisValue;
-        core::math::Vector2 Position;
+        // monotonic time at which the event was pushed, in nanoseconds (see InputClock).
+        uint64_t Timestamp{0};
+        // time at which the hardware sampled the input, if the device reports it; in InputClock nanoseconds, 0 if
+        // unknown.
+        uint64_t HardwareTimestamp{0};
     };
+
+    static_assert(sizeof(InputKeyEventData) <= 16 && sizeof(InputAxisEventData) <= 16 &&
+                  sizeof(InputCharEventData) <= 16 && sizeof(InputPointerEventData) <= 16,
+                  "input event payloads must fit in 16 bytes");
+    static_assert(std::is_trivially_copyable_v<InputEvent>, "InputEvent must be trivially copyable");
+    static_assert(sizeof(InputEvent) == 32, "InputEvent layout has changed");
+    static_assert(alignof(InputEvent) == 8, "InputEvent alignment has changed");
 }
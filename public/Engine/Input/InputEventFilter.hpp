@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include <Engine/Core/Math/Vector2.hpp>
+
+#include <Engine/Input/InputEvent.hpp>
+#include <Engine/Input/InputListener.hpp>
+#include <Engine/Input/IVirtualKeyboard.hpp>
+
+namespace engine::input {
+    // Pre-dispatch stage of InputManager::ProcessEvents. Filters see the whole batch at once: they take whatever
+    // state they depend on once in BeginBatch, then reject events by flagging them in a tight loop.
+    struct IInputEventFilter {
+        virtual ~IInputEventFilter() = default;
+
+        // returns false if the filter won't reject anything in this batch, which skips its Filter call.
+        virtual bool BeginBatch() = 0;
+
+        // sets INPUT_EVENT_FLAG_FILTERED on the events to reject
+        virtual void Filter(InputEvent *events, size_t count) = 0;
+    };
+
+    // Rejects key changes and the touches on the virtual keyboard while it is shown, as configured by its
+    // GetInputIgnoreTarget. Installed on every input manager by default.
+    struct InputVirtualKeyboardFilter : IInputEventFilter {
+        bool BeginBatch() override;
+
+        void Filter(InputEvent *events, size_t count) override;
+
+    protected:
+        // snapshot taken by BeginBatch
+        IVirtualKeyboard *m_Keyboard{nullptr};
+        InputIgnoreTarget m_IgnoreTarget{INPUT_IGNORE_TARGET_NONE};
+        bool b_HasBounds{false};
+        core::math::Vector2 m_BoundsMin;
+        core::math::Vector2 m_BoundsMax;
+    };
+
+    // Rejects every event of the blocked types, e.g. while the window has lost focus or a pause menu is open.
+    struct InputEventTypeFilter : IInputEventFilter {
+        // may be called from any thread; takes effect with the next batch
+        void SetBlockedTypes(InputEventMask mask) {
+            m_BlockedTypes.store(mask, std::memory_order_relaxed);
+        }
+
+        InputEventMask GetBlockedTypes() const {
+            return m_BlockedTypes.load(std::memory_order_relaxed);
+        }
+
+        bool BeginBatch() override;
+
+        void Filter(InputEvent *events, size_t count) override;
+
+    protected:
+        std::atomic<InputEventMask> m_BlockedTypes{INPUT_EVENT_MASK_NONE};
+        InputEventMask m_BatchBlockedTypes{INPUT_EVENT_MASK_NONE};
+    };
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include <Engine/Input/InputEvent.hpp>
+
+namespace engine::input {
+    // Bounded lock-free multi-producer / single-consumer ring used to hand events from the device threads over to
+    // the thread calling InputManager::ProcessEvents.
+    // Overflow policy: producers never block; an event pushed into a full queue is dropped and accounted for in the
+    // dropped counter, so the events that are already queued keep their order.
+    struct InputEventQueue {
+        static constexpr size_t DefaultCapacity = 4096;
+
+        explicit InputEventQueue(size_t capacity = DefaultCapacity);
+
+        ~InputEventQueue() = default;
+
+        InputEventQueue(const InputEventQueue &) = delete;
+
+        InputEventQueue &operator=(const InputEventQueue &) = delete;
+
+        // safe to call from any number of threads; returns false if the event was dropped.
+        bool Push(const InputEvent &event);
+
+        // must only be called by the consumer; appends all the available events to "out" and returns their count.
+        size_t Drain(std::vector<InputEvent> &out);
+
+        // returns the amount of events dropped since the last call.
+        uint64_t ConsumeDroppedCount();
+
+        size_t GetCapacity() const;
+
+    protected:
+        static constexpr size_t CacheLineSize = 64;
+
+        struct Slot {
+            std::atomic<size_t> Sequence;
+            InputEvent Event;
+        };
+
+        std::unique_ptr<Slot[]> m_Slots;
+        size_t m_Mask;
+
+        // producers and consumer live on different cache lines to avoid false sharing.
+        alignas(CacheLineSize) std::atomic<size_t> m_EnqueuePos;
+        alignas(CacheLineSize) size_t m_DequeuePos;
+        std::atomic<uint64_t> m_DroppedCount;
+    };
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine::input {
+    struct InputHistorySample {
+        // when the value took effect, in InputClock nanoseconds
+        uint64_t Timestamp;
+        double Value;
+    };
+
+    // Bounded history of the changes of one value, oldest first. Once full, every new sample evicts the oldest one,
+    // so queries are exact back to GetOldestTimestamp and report the last evicted value before that. Samples are kept
+    // in timestamp order, which lets both queries binary search the ring.
+    struct InputHistory {
+        static constexpr size_t DefaultCapacity = 64;
+
+        // rounded up to a power of two; the ring itself is only allocated by the first Push
+        explicit InputHistory(size_t capacity = DefaultCapacity);
+
+        // samples repeating the latest value are dropped; samples stamped before the latest one are moved up to it
+        void Push(uint64_t timestamp, double value);
+
+        // value in effect at the given time
+        double GetValueAt(uint64_t timestamp) const;
+
+        // appends the changes with begin <= Timestamp < end to transitions, returns how many were appended
+        size_t GetTransitions(uint64_t begin, uint64_t end, std::vector<InputHistorySample> &transitions) const;
+
+        double GetLatestValue() const {
+            return m_Count > 0 ? At(m_Count - 1).Value : m_EvictedValue;
+        }
+
+        // 0 if nothing was recorded yet
+        uint64_t GetOldestTimestamp() const {
+            return m_Count > 0 ? At(0).Timestamp : 0;
+        }
+
+        size_t GetSize() const {
+            return m_Count;
+        }
+
+        size_t GetCapacity() const {
+            return m_Capacity;
+        }
+
+        void Clear();
+
+    protected:
+        const InputHistorySample &At(size_t index) const {
+            return m_Samples[(m_Head + index) & (m_Capacity - 1)];
+        }
+
+        // index of the first sample stamped after the given time, or stamped at or after it if inclusive is set
+        size_t Find(uint64_t timestamp, bool inclusive) const;
+
+        std::vector<InputHistorySample> m_Samples;
+        size_t m_Capacity;
+        size_t m_Head{0};
+        size_t m_Count{0};
+        // value before the oldest retained sample
+        double m_EvictedValue{0.0};
+    };
+}
@@ -1,22 +1,26 @@
 #pragma once
 
-#include <unordered_map>
-#include <string>
 #include <string_view>
+#include <cstdint>
+
+#include <Engine/Input/InputNameRegistry.hpp>
 
 namespace engine::input {
     // The Input Key Handle represents the hashed name identifier of a key.
     using InputKeyHandle = uint32_t;
 
+    // Lookups are lock-free and safe from any thread, including while other threads register keys.
     struct InputKeyRepository {
         virtual ~InputKeyRepository() = default;
 
         static InputKeyRepository& Instance();
 
-        std::string GetKey(InputKeyHandle handle);
-        bool HasKey(InputKeyHandle handle);
+        // returns a null-terminated view valid for the lifetime of the repository, or an empty view for unknown keys.
+        std::string_view GetKey(InputKeyHandle handle) const;
+        bool HasKey(InputKeyHandle handle) const;
         InputKeyHandle AddKey(std::string_view keyName);
     protected:
-        std::unordered_map<InputKeyHandle, std::string> m_KeyList;
+        // runtime registered keys; the built-in ones live in a compile-time table
+        InputNameRegistry m_KeyList;
     };
 }
\ No newline at end of file
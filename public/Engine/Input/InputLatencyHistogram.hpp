@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine::input {
+    // HDR-style histogram of latencies in nanoseconds: every power of two is split into 8 linear sub-buckets, so any
+    // recorded value is known to within 12.5% from 1 ns up to ~18 minutes, in a fixed 2.5 KiB of counters.
+    // Recording is lock-free and meant for a single writer (the dispatching thread); snapshots may be taken from any
+    // thread at any time.
+    struct InputLatencyHistogram {
+        static constexpr uint32_t SubBucketBits = 3;
+        static constexpr uint32_t SubBucketCount = 1 << SubBucketBits;
+        // values at or above 2^MaxExponent are counted in the last bucket
+        static constexpr uint32_t MaxExponent = 40;
+        static constexpr size_t BucketCount = (MaxExponent - SubBucketBits + 1) * SubBucketCount;
+
+        // plain copy of the counters, with the statistics derived from them
+        struct Snapshot {
+            std::array<uint64_t, BucketCount> Counts{};
+            uint64_t TotalCount{0};
+            uint64_t Sum{0};
+            uint64_t Max{0};
+
+            // adds another snapshot, e.g. to combine the histograms of several devices
+            void Merge(const Snapshot &other);
+
+            double GetMean() const;
+
+            // upper bound of the bucket holding the given percentile (0..100); 0 if nothing was recorded
+            uint64_t GetValueAtPercentile(double percentile) const;
+        };
+
+        static constexpr size_t GetBucketIndex(uint64_t value) {
+            if (value < SubBucketCount) {
+                return static_cast<size_t>(value);
+            }
+
+            uint32_t exponent = static_cast<uint32_t>(std::bit_width(value)) - 1;
+
+            if (exponent >= MaxExponent) {
+                return BucketCount - 1;
+            }
+
+            return (exponent - SubBucketBits + 1) * SubBucketCount +
+                   ((value >> (exponent - SubBucketBits)) & (SubBucketCount - 1));
+        }
+
+        // largest value counted in the given bucket
+        static constexpr uint64_t GetBucketUpperBound(size_t index) {
+            if (index < SubBucketCount) {
+                return index;
+            }
+
+            uint32_t exponent = static_cast<uint32_t>(index / SubBucketCount) + SubBucketBits - 1;
+            uint64_t subBucket = index % SubBucketCount;
+
+            return ((SubBucketCount + subBucket + 1) << (exponent - SubBucketBits)) - 1;
+        }
+
+        void Record(uint64_t nanoseconds);
+
+        Snapshot GetSnapshot() const;
+
+        void Reset();
+
+    protected:
+        // there is a single writer, so counters are bumped with plain loads and stores rather than read-modify-writes
+        static void Increment(std::atomic<uint64_t> &counter, uint64_t value) {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        std::array<std::atomic<uint64_t>, BucketCount> m_Counts{};
+        std::atomic<uint64_t> m_TotalCount{0};
+        std::atomic<uint64_t> m_Sum{0};
+        std::atomic<uint64_t> m_Max{0};
+    };
+
+    static_assert(InputLatencyHistogram::GetBucketIndex(7) == 7, "histogram bucket layout is broken");
+    static_assert(InputLatencyHistogram::GetBucketIndex(8) == 8 && InputLatencyHistogram::GetBucketIndex(15) == 15,
+                  "histogram bucket layout is broken");
+    static_assert(InputLatencyHistogram::GetBucketIndex(16) == 16 && InputLatencyHistogram::GetBucketIndex(17) == 16,
+                  "histogram bucket layout is broken");
+    static_assert(InputLatencyHistogram::GetBucketUpperBound(16) == 17 &&
+                  InputLatencyHistogram::GetBucketUpperBound(23) == 31, "histogram bucket layout is broken");
+    static_assert(InputLatencyHistogram::GetBucketIndex(UINT64_MAX) == InputLatencyHistogram::BucketCount - 1,
+                  "histogram bucket layout is broken");
+}
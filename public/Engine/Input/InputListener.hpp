@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+
+#include <Engine/Input/InputEvent.hpp>
+
+namespace engine::input {
+    // Bit set of InputEventType values a listener is interested in.
+    using InputEventMask = uint32_t;
+
+    constexpr InputEventMask INPUT_EVENT_MASK_NONE = 0;
+    constexpr InputEventMask INPUT_EVENT_MASK_ALL = (InputEventMask{1} << INPUT_EVENT_TYPE_COUNT) - 1;
+
+    constexpr InputEventMask InputEventMaskOf(InputEventType type) {
+        return InputEventMask{1} << type;
+    }
+
+    static_assert(INPUT_EVENT_TYPE_COUNT <= 32, "InputEventMask can't hold every event type");
+
+    // Listeners are called in descending priority; listeners of equal priority in the order they subscribed.
+    enum InputListenerPriority : int32_t {
+        INPUT_LISTENER_PRIORITY_LOW = -1000,
+        INPUT_LISTENER_PRIORITY_DEFAULT = 0,
+        INPUT_LISTENER_PRIORITY_HIGH = 1000
+    };
+
+    // Player scope of a listener that receives the events of every player, including the ones that don't belong to
+    // any (INPUT_PLAYER_ID_NONE). Any other scope is a player id, as reported by IInputDevice::GetPlayerId.
+    constexpr int32_t INPUT_LISTENER_PLAYER_ALL = -1;
+
+    // Non-owning callable: a function pointer plus the object it's called on. It never allocates, so it can be
+    // copied into the per-type listener lists freely. Returning true consumes the event.
+    struct InputEventDelegate {
+        using Function = bool (*)(void *context, const InputEvent &event);
+
+        InputEventDelegate() = default;
+
+        // calls "instance->*Method(event)", e.g. InputEventDelegate::Bind<&InputSystem::InternalInputCallback>(this)
+        template<auto Method, typename T>
+        static InputEventDelegate Bind(T *instance) {
+            return {[](void *context, const InputEvent &event) -> bool {
+                return (static_cast<T *>(context)->*Method)(event);
+            }, instance};
+        }
+
+        // calls "(*callable)(event)"; the callable (e.g. a lambda) has to outlive the subscription.
+        template<typename T>
+        static InputEventDelegate Bind(T *callable) {
+            return {[](void *context, const InputEvent &event) -> bool {
+                return (*static_cast<T *>(context))(event);
+            }, callable};
+        }
+
+        template<bool (*Func)(const InputEvent &)>
+        static InputEventDelegate Bind() {
+            return {[](void *, const InputEvent &event) -> bool {
+                return Func(event);
+            }, nullptr};
+        }
+
+        bool operator()(const InputEvent &event) const {
+            return m_Function(m_Context, event);
+        }
+
+        explicit operator bool() const {
+            return m_Function != nullptr;
+        }
+
+    protected:
+        InputEventDelegate(Function function, void *context) : m_Function(function), m_Context(context) {}
+
+        Function m_Function{nullptr};
+        void *m_Context{nullptr};
+    };
+
+    // Returned by InputManager::AddInputListener and required to remove the listener again.
+    struct InputListenerToken {
+        uint32_t Id{0};
+
+        bool IsValid() const {
+            return Id != 0;
+        }
+    };
+}
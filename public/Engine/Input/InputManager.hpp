@@ -1,23 +1,72 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <mutex>
 #include <string_view>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <functional>
+#include <memory>
 
-#include <Engine/Core/Runtime/IThread.hpp>
 #include <Engine/Core/Math/Vector2.hpp>
 #include <Engine/Core/Runtime/IMutex.hpp>
 
+#include <Engine/Input/IInputDevice.hpp>
 #include <Engine/Input/InputEvent.hpp>
+#include <Engine/Input/InputEventQueue.hpp>
+#include <Engine/Input/InputListener.hpp>
+#include <Engine/Input/InputRecording.hpp>
+#include <Engine/Input/InputLatencyHistogram.hpp>
+#include <Engine/Input/InputEventFilter.hpp>
 
 namespace engine::input {
-    struct IInputDevice;
+    struct InputPollGroup;
+
+    // Scheduling options of a registered device.
+    struct InputDevicePollConfig {
+        // fixed poll rate for devices without a wait handle; zero uses the manager's poll interval.
+        std::chrono::microseconds Interval{0};
+        // maximum time a single Poll() may take; a device in the shared poll thread that exceeds it is moved to a
+        // dedicated thread so that it can't delay the other devices. zero disables the check.
+        std::chrono::microseconds Budget{0};
+        // poll the device on its own thread from the start.
+        bool Dedicated{false};
+    };
+
+    // Called once an unregistered device was Destroy()ed and nothing references it anymore, so that it can be freed.
+    using InputDeviceReleasedDelegate = std::function<void(IInputDevice *)>;
+
+    // Construction options of an input manager. The defaults suit the global one; headless contexts, e.g. bots
+    // driven by a server, can shrink their footprint to a few KB.
+    struct InputManagerConfig {
+        // rounded up to a power of two
+        size_t EventQueueCapacity{InputEventQueue::DefaultCapacity};
+        // the histogram table is only allocated for managers created with tracking enabled; see SetLatencyTracking
+        bool TrackLatency{true};
+        // installs the virtual keyboard filter
+        bool FilterVirtualKeyboard{true};
+    };
+
+    // Point from which the latency of an event is measured; both end when ProcessEvents starts dispatching it.
+    enum InputLatencySource : uint8_t {
+        // time the event spent queued between Push* and dispatch
+        INPUT_LATENCY_SOURCE_PUSH,
+        // time since the hardware sampled the input; only events with a hardware timestamp are counted
+        INPUT_LATENCY_SOURCE_HARDWARE,
+
+        INPUT_LATENCY_SOURCE_COUNT
+    };
 
     struct InputManager {
-        using InputEventDelegate = std::function<bool(const InputEvent &)>;
+        // rate at which devices without a wait handle are polled by default (1 kHz)
+        static constexpr std::chrono::microseconds DefaultPollInterval{1000};
 
-        InputManager();
+        // Managers are independent of each other: besides the global one, any number of them may be created, e.g. one
+        // per simulated player, and driven from any thread through ProcessEvents. They only share the key and axis
+        // repositories. Device threads are only created by Initialize or the first RegisterDevice.
+        explicit InputManager(const InputManagerConfig &config = {});
 
         ~InputManager();
 
@@ -29,43 +78,194 @@ namespace engine::input {
 
 #ifdef SHOW_PRIVATE_API
         // make sure that certain related to pushing APIs are not exposed to everyone. we wouldn't want anyone to push fake input data, would we?
-        void PushKeyStateChange(InputKeyHandle key, bool newKeyState);
-        void PushInputChar(uint16_t ch);
-        void PushAxisChange(InputAxisHandle axis, float value);
-        void PushMousePosition(core::math::Vector2 position);
+        // devices that know when the hardware sampled the input pass it as "hardwareTimestamp", converted to
+        // InputClock nanoseconds.
+        void PushKeyStateChange(InputKeyHandle key, bool newKeyState, uint64_t hardwareTimestamp = 0);
+        void PushInputChar(uint16_t ch, uint64_t hardwareTimestamp = 0);
+        void PushAxisChange(InputAxisHandle axis, float value, uint64_t hardwareTimestamp = 0);
+        void PushMousePosition(core::math::Vector2 position, uint64_t hardwareTimestamp = 0);
 
         // Touchscreen API
-        void PushTouchMove(int fingerId, core::math::Vector2 position);
-        void PushTouchUp(int fingerId, core::math::Vector2 position);
-        void PushTouchDown(int fingerId, core::math::Vector2 position);
+        void PushTouchMove(int fingerId, core::math::Vector2 position, uint64_t hardwareTimestamp = 0);
+        void PushTouchUp(int fingerId, core::math::Vector2 position, uint64_t hardwareTimestamp = 0);
+        void PushTouchDown(int fingerId, core::math::Vector2 position, uint64_t hardwareTimestamp = 0);
+
+        // pushes an event as it is, keeping its player; used to feed recorded input back in. the recorded device id
+        // belongs to another run, so the event is attributed to the polling device like any other. returns false if
+        // the event queue is full.
+        bool PushRecordedEvent(InputEvent event);
 #endif
 
         std::vector<IInputDevice *> GetDevices();
 
-        void RegisterDevice(IInputDevice *device);
+        void RegisterDevice(IInputDevice *device, const InputDevicePollConfig &config = {});
+
+        // doesn't wait for the device's poll thread: the device is Destroy()ed once that thread stopped using it,
+        // possibly after this returns and on that thread. "onReleased" then tells when the device can be freed; it
+        // runs on whichever thread destroyed the device, possibly before this returns and with the device lock held,
+        // so it must not register or unregister devices. it isn't called if the device wasn't registered.
+        void UnregisterDevice(IInputDevice *device, InputDeviceReleasedDelegate onReleased = nullptr);
+
+        void SetPollInterval(std::chrono::microseconds interval);
+
+        std::chrono::microseconds GetPollInterval() const;
 
-        void UnregisterDevice(IInputDevice *device);
+        // when enabled, mouse, touch move and axis samples that are superseded by a later sample within the same
+        // batch are only delivered to the listeners that asked for them. key, char and touch up/down events act as
+        // barriers, so samples are never merged across them.
+        void SetEventCoalescing(bool enabled);
 
-        void AddInputListener(InputEventDelegate listener, bool hasHighPriority = false);
+        bool IsEventCoalescingEnabled() const;
 
-        void RemoveInputListener(InputEventDelegate listener);
+        // the listener is only called for the event types in "eventMask". listeners only see the latest sample of
+        // coalesced events unless "receiveSupersededSamples" is set. a listener scoped to a "player" is kept apart
+        // from the other players' listeners, so it costs nothing while dispatching their events.
+        InputListenerToken AddInputListener(InputEventDelegate listener, InputEventMask eventMask = INPUT_EVENT_MASK_ALL,
+                                            int32_t priority = INPUT_LISTENER_PRIORITY_DEFAULT,
+                                            bool receiveSupersededSamples = false,
+                                            int32_t player = INPUT_LISTENER_PLAYER_ALL);
+
+        // returns false if the token doesn't belong to a subscribed listener. waits for a ProcessEvents call running
+        // on another thread, so that the listener can be destroyed right after; from within a listener, the rest of
+        // the current batch may still reach it.
+        bool RemoveInputListener(InputListenerToken token);
+
+        // filters run in the order they were added, before coalescing and before any listener sees the batch, so
+        // that the samples they reject never hide earlier ones. the filter must stay alive until it is removed. the
+        // virtual keyboard filter is installed by default.
+        void AddEventFilter(IInputEventFilter *filter);
+
+        // waits like RemoveInputListener
+        void RemoveEventFilter(IInputEventFilter *filter);
+
+        // records every event handed to ProcessEvents, before any filtering or coalescing, until StopRecording is
+        // called. recordings are played back through InputReplayDevice.
+        bool StartRecording(const std::filesystem::path &path);
+
+        void StopRecording();
+
+        bool IsRecording();
+
+        // latency histograms are kept per event type and device while enabled (the default). has no effect on
+        // managers created without InputManagerConfig::TrackLatency.
+        void SetLatencyTracking(bool enabled);
+
+        bool IsLatencyTrackingEnabled() const;
+
+        // "device" selects the events of a single device; nullptr combines every device and the events pushed
+        // outside of a device poll.
+        InputLatencyHistogram::Snapshot GetLatencyHistogram(InputLatencySource source, InputEventType type,
+                                                            IInputDevice *device = nullptr);
+
+        void ResetLatencyHistograms();
 
         static InputManager *Instance();
 
     protected:
-        void PushEvent(InputEvent event);
+        struct InputListener {
+            InputEventDelegate Delegate;
+            InputListenerToken Token;
+            int32_t Priority;
+            bool ReceivesSupersededSamples;
+        };
+
+        using InputListenerList = std::vector<InputListener>;
 
-        void ProcessTask();
+        // listeners and filters as seen by a dispatch; immutable once published
+        struct DispatchTable {
+            // one list per event type, sorted by priority, so an event only visits the listeners interested in it
+            InputListenerList Listeners[INPUT_EVENT_TYPE_COUNT];
+            // same for the listeners scoped to one player, indexed by player id; grown on demand
+            std::vector<std::array<InputListenerList, INPUT_EVENT_TYPE_COUNT>> PlayerListeners;
+            std::vector<IInputEventFilter *> Filters;
+        };
 
+        static void InsertListener(InputListenerList &listeners, const InputListener &listener);
+
+        static bool EraseListener(InputListenerList &listeners, InputListenerToken token);
+
+        // calls the listeners of both lists in priority order until one consumes the event
+        static void DispatchEvent(const InputEvent &event, const InputListenerList &listeners,
+                                  const InputListenerList &playerListeners);
+
+        // copy of the current table to change and publish; mtx_InputProc must be held.
+        std::shared_ptr<DispatchTable> CopyDispatchTable() const;
+
+        // waits for a ProcessEvents call running on another thread; returns right away from within a listener
+        void WaitForDispatch();
+
+        void PushEvent(InputEvent event, uint64_t hardwareTimestamp);
+
+        void RecordLatencies(uint64_t now);
+
+        // hands out the id events of the device are tagged with; guarded by mtx_DeviceProc.
+        uint8_t AcquireDeviceId(IInputDevice *device);
+
+        uint8_t FindDeviceId(IInputDevice *device) const;
+
+        void ReleaseDeviceId(IInputDevice *device);
+
+        void CoalesceEvents();
+
+        void IsolateDevice(IInputDevice *device);
+
+        // stops every poll thread, then destroys and forgets every registered device; mtx_InputProc must be held.
+        void ReleaseDevices();
+
+        InputPollGroup &CreateDedicatedGroup(IInputDevice *device);
+
+        // moves the retired groups whose thread has exited to "out", to be destroyed once mtx_DeviceProc is released;
+        // mtx_DeviceProc must be held.
+        void ReapPollGroups(std::vector<std::unique_ptr<InputPollGroup>> &out);
+
+        // creates the shared group on first use; mtx_DeviceProc must be held.
+        InputPollGroup &GetSharedPollGroup();
+
+        // guards the dispatch table and the recorder; event producers never take it, and listeners and filters are
+        // called without it.
         std::unique_ptr<core::runtime::IMutex> mtx_InputProc;
+        // held by ProcessEvents for the whole call
+        std::unique_ptr<core::runtime::IMutex> mtx_DispatchProc;
         std::unique_ptr<core::runtime::IMutex> mtx_DeviceProc;
 
-        std::vector<IInputDevice *> m_DeviceList;
-        std::vector<InputEvent> m_Events;
+        // guarded by mtx_DeviceProc; every group polls its own devices on its own thread. the shared group is null
+        // until a device or Initialize needs it.
+        std::unique_ptr<InputPollGroup> m_SharedPollGroup;
+        std::vector<std::unique_ptr<InputPollGroup>> m_DedicatedPollGroups;
+        // emptied dedicated groups whose thread was asked to stop; joined once it did, never while waiting for it
+        std::vector<std::unique_ptr<InputPollGroup>> m_RetiredPollGroups;
+        // device of every id; the id of a device is its index + 1
+        std::vector<IInputDevice *> m_DeviceIds;
+
+        InputEventQueue m_EventQueue;
+        // events drained from the queue for the current dispatch; kept around to reuse its storage.
+        std::vector<InputEvent> m_DispatchEvents;
+
+        // copy-on-write: changes publish a new table, while a dispatch keeps using the one it started with. guarded
+        // by mtx_InputProc, like the token counter and the recorder.
+        std::shared_ptr<const DispatchTable> m_DispatchTable;
+        uint32_t m_NextListenerToken;
 
-        std::unique_ptr<core::runtime::IThread> m_Thread;
-        std::vector<InputEventDelegate> m_InputDelegates;
+        InputRecorder m_Recorder;
+
+        InputVirtualKeyboardFilter m_VirtualKeyboardFilter;
+
+        // created by the dispatching thread on the first event of their source, device and event type; see
+        // GetLatencyHistogramSlot. the table itself is null if the manager was created without latency tracking.
+        static constexpr size_t LatencyHistogramCount = INPUT_LATENCY_SOURCE_COUNT * 256 * INPUT_EVENT_TYPE_COUNT;
+
+        static size_t GetLatencyHistogramSlot(InputLatencySource source, uint8_t device, InputEventType type) {
+            return (static_cast<size_t>(source) * 256 + device) * INPUT_EVENT_TYPE_COUNT + type;
+        }
+
+        std::unique_ptr<std::atomic<InputLatencyHistogram *>[]> m_LatencyHistograms;
+        // coalescing keys of the samples seen while walking the current batch backwards
+        std::vector<uint64_t> m_CoalesceKeys;
 
         bool b_IsInit;
+
+        std::atomic<std::chrono::microseconds> m_PollInterval;
+        std::atomic<bool> b_CoalesceEvents;
+        std::atomic<bool> b_TrackLatency;
     };
 }
\ No newline at end of file
@@ -4,5 +4,9 @@ namespace engine::input {
     struct InputModule {
         static void ModuleStartup();
         static void ModuleShutdown();
+
+        // re-reads the binding config and publishes it to the input system; may be called from any thread, e.g. a
+        // file watcher or loader job. the current bindings are kept if the config can't be loaded.
+        static bool ReloadBindings();
     };
 }
\ No newline at end of file
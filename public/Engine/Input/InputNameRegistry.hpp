@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine::input {
+    // Append-only handle to name registry backing the key and axis repositories.
+    // Lookups are lock-free and safe from any thread: they probe an open-addressed table whose slots are only ever
+    // filled, never changed. Registrations are serialized among themselves but never block readers; when the table
+    // grows, the new one is published with a single atomic store and the old one stays alive for late readers.
+    // Names are interned, so the returned views are null-terminated and valid for the lifetime of the registry.
+    struct InputNameRegistry {
+        InputNameRegistry();
+
+        ~InputNameRegistry() = default;
+
+        InputNameRegistry(const InputNameRegistry &) = delete;
+
+        InputNameRegistry &operator=(const InputNameRegistry &) = delete;
+
+        // returns an empty view if the handle isn't registered.
+        std::string_view Find(uint32_t handle) const;
+
+        bool Contains(uint32_t handle) const;
+
+        // registers the name under the handle if it isn't known yet and returns the interned name.
+        std::string_view Add(uint32_t handle, std::string_view name);
+
+    protected:
+        static constexpr size_t InitialCapacity = 64;
+
+        struct Slot {
+            std::atomic<uint32_t> Handle{0};
+            // published last; a null name marks a free slot
+            std::atomic<const std::string *> Name{nullptr};
+        };
+
+        struct Table {
+            explicit Table(size_t capacity) : Slots(std::make_unique<Slot[]>(capacity)), Mask(capacity - 1) {}
+
+            std::unique_ptr<Slot[]> Slots;
+            size_t Mask;
+        };
+
+        static const std::string *FindIn(const Table &table, uint32_t handle);
+
+        static void InsertInto(Table &table, uint32_t handle, const std::string *name);
+
+        std::atomic<Table *> m_Table;
+
+        // writer side
+        std::mutex mtx_Write;
+        std::deque<std::string> m_Names;
+        std::vector<std::unique_ptr<Table>> m_Tables;
+        size_t m_Count;
+    };
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <cstddef>
+#include <cstdint>
+
+#include <Engine/Input/InputEvent.hpp>
+
+namespace engine::input {
+    // Input recordings are a header followed by the recorded events, copied as they are; the events keep their push
+    // timestamp and the device and player they came from. Files are only appended to, so a recording that was cut
+    // short (e.g. by a crash) still replays up to its last complete event.
+    struct InputRecordingHeader {
+        static constexpr uint32_t FileMagic = 0x43524952; // "RIRC"
+        static constexpr uint32_t FileVersion = 2;
+
+        uint32_t Magic{FileMagic};
+        uint32_t Version{FileVersion};
+        uint32_t EventSize{sizeof(InputEvent)};
+        uint32_t Reserved{0};
+
+        bool IsValid() const {
+            return Magic == FileMagic && Version == FileVersion && EventSize == sizeof(InputEvent);
+        }
+    };
+
+    static_assert(sizeof(InputRecordingHeader) == 16, "input recording header layout has changed");
+
+    // Appends events to a recording; see InputManager::StartRecording.
+    struct InputRecorder {
+        // starts a new recording, replacing any existing file
+        bool Open(const std::filesystem::path &path);
+
+        void Close();
+
+        bool IsOpen() const {
+            return m_Stream.is_open();
+        }
+
+        void Append(const InputEvent *events, size_t count);
+
+    protected:
+        std::ofstream m_Stream;
+    };
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+#include <Engine/Input/IInputDevice.hpp>
+#include <Engine/Input/InputEvent.hpp>
+
+namespace engine::input {
+    struct InputMappedFile;
+    struct InputManager;
+
+    // Plays a recording made through InputManager::StartRecording back into the input manager. The recording is
+    // memory-mapped and its events are pushed as they are, at their original pace scaled by "speed"; a speed of zero
+    // pushes them as fast as the event queue takes them. Events that don't fit into the queue are pushed on the next
+    // poll, so nothing is dropped. A "playerId" of 0 or more replays every event as that player's; -1 keeps the
+    // players the events were recorded with.
+    struct InputReplayDevice : IInputDevice {
+        explicit InputReplayDevice(std::filesystem::path path, double speed = 1.0, int playerId = -1);
+
+        ~InputReplayDevice() override;
+
+        bool Initialize() override;
+
+        void Destroy() override;
+
+        void Poll() override;
+
+        std::string GetName() const override;
+
+        int GetPlayerId() override;
+
+        // starts over from the first event
+        void Rewind();
+
+        bool IsFinished() const;
+
+        size_t GetEventCount() const;
+
+        size_t GetReplayedEventCount() const;
+
+        // pushes into the given manager rather than the global one, e.g. to drive a headless input context by
+        // calling Poll from its own worker
+        void SetManager(InputManager *manager) {
+            m_Manager = manager;
+        }
+
+    protected:
+        std::filesystem::path m_Path;
+        double m_Speed;
+        int m_PlayerId;
+        // null for the global manager
+        InputManager *m_Manager{nullptr};
+
+        std::unique_ptr<InputMappedFile> m_File;
+        size_t m_EventCount;
+        size_t m_NextEvent;
+
+        // clock time at which the replay (re)started, and the timestamp of the first recorded event
+        uint64_t m_StartTime;
+        uint64_t m_FirstTimestamp;
+    };
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <initializer_list>
+#include <cstddef>
+#include <cstdint>
+
+#include <Engine/Core/Math/Vector2.hpp>
+
+#include <Engine/Input/InputKeyRepository.hpp>
+#include <Engine/Input/InputBindingTable.hpp>
+
+namespace engine::input {
+    struct InputTouchState {
+        bool IsDown{false};
+        core::math::Vector2 Position;
+    };
+
+    // Set of keys for IsAnyKeyDown/WasAnyKeyPressed, e.g. every key that skips a cutscene. Built-in keys are kept as
+    // a bitset over the built-in key table, so testing a group against a snapshot is a handful of ANDs.
+    struct InputKeyGroup {
+        InputKeyGroup() = default;
+
+        InputKeyGroup(std::initializer_list<InputKeyHandle> keys);
+
+        void Add(InputKeyHandle key);
+
+        std::array<uint64_t, 4> BuiltinKeyBits{};
+        // sorted
+        std::vector<InputKeyHandle> OtherKeys;
+    };
+
+    // Immutable state of the input system as of one InputSystem::Update call. Snapshots are recycled: one obtained
+    // through InputSystem::GetSnapshot stays untouched through the next two Update calls and is rewritten by the
+    // third, so jobs started during a frame may keep reading it until the end of the next frame.
+    struct InputStateSnapshot {
+        // touches with a higher finger id aren't tracked
+        static constexpr size_t MaxTouches = 10;
+
+        double GetAxis(InputAxisId axis) const {
+            return axis.Index < AxisValues.size() ? AxisValues[axis.Index] : 0.0;
+        }
+
+        double GetAxis(InputMapHandle mapHandle) const;
+
+        bool GetButton(InputButtonId button) const {
+            return TestBit(ButtonBits, button.Index);
+        }
+
+        bool GetButton(InputMapHandle mapHandle) const;
+
+        // pressed since the previous snapshot
+        bool GetButtonDown(InputButtonId button) const {
+            return TestBit(ButtonPressedBits, button.Index);
+        }
+
+        bool GetButtonDown(InputMapHandle mapHandle) const;
+
+        // released since the previous snapshot
+        bool GetButtonUp(InputButtonId button) const {
+            return TestBit(ButtonReleasedBits, button.Index);
+        }
+
+        bool GetButtonUp(InputMapHandle mapHandle) const;
+
+        // nanoseconds since the first snapshot that had the button held, 0 if it isn't held. Frame granular: a button
+        // pressed in this snapshot reads as held for 0 ns.
+        uint64_t GetButtonHeldFor(InputButtonId button) const {
+            return GetButton(button) && button.Index < ButtonPressTimes.size()
+                   ? Timestamp - ButtonPressTimes[button.Index] : 0;
+        }
+
+        uint64_t GetButtonHeldFor(InputMapHandle mapHandle) const;
+
+        // completed since the previous snapshot
+        bool WasComboTriggered(InputComboId combo) const {
+            return TestBit(ComboTriggeredBits, combo.Index);
+        }
+
+        bool WasComboTriggered(InputMapHandle mapHandle) const;
+
+        bool IsKeyDown(InputKeyHandle key) const;
+
+        bool WasKeyPressed(InputKeyHandle key) const;
+
+        bool WasKeyReleased(InputKeyHandle key) const;
+
+        bool IsAnyKeyDown() const;
+
+        bool IsAnyKeyDown(const InputKeyGroup &group) const;
+
+        bool WasAnyKeyPressed() const;
+
+        bool WasAnyKeyPressed(const InputKeyGroup &group) const;
+
+        // derives the pressed and released sets from the state of the previous snapshot, and carries the press times
+        // over. called once per frame by InputSystem::Update.
+        void DiffWith(const InputStateSnapshot &previous);
+
+        const core::math::Vector2 &GetMousePosition() const {
+            return MousePosition;
+        }
+
+        // released touches keep their last position
+        const InputTouchState &GetTouch(size_t finger) const {
+            static const InputTouchState none;
+            return finger < MaxTouches ? Touches[finger] : none;
+        }
+
+        static bool TestBit(const std::vector<uint64_t> &bits, uint32_t index) {
+            return (index >> 6) < bits.size() && ((bits[index >> 6] >> (index & 63)) & 1);
+        }
+
+        // number of the Update call that produced the snapshot, and when it ran (see InputClock)
+        uint64_t Frame{0};
+        uint64_t Timestamp{0};
+
+        // bindings the state was accumulated with; resolves handle queries
+        std::shared_ptr<const InputBindingTable> Bindings;
+
+        // indexed like the input system's ids
+        std::vector<double> AxisValues{0.0};
+        std::vector<uint64_t> ButtonBits{0};
+        // edges relative to the previous snapshot, same layout as ButtonBits
+        std::vector<uint64_t> ButtonPressedBits{0};
+        std::vector<uint64_t> ButtonReleasedBits{0};
+        // indexed by button id: timestamp of the first snapshot the button was held in
+        std::vector<uint64_t> ButtonPressTimes{0};
+        // indexed by combo id
+        std::vector<uint64_t> ComboTriggeredBits{0};
+
+        // raw key state, bound or not: built-in keys by their slot in the built-in key table, every other key in a
+        // sorted list.
+        std::array<uint64_t, 4> BuiltinKeyBits{};
+        std::vector<InputKeyHandle> OtherKeysDown;
+        std::array<uint64_t, 4> BuiltinKeyPressedBits{};
+        std::array<uint64_t, 4> BuiltinKeyReleasedBits{};
+        std::vector<InputKeyHandle> OtherKeysPressed;
+        std::vector<InputKeyHandle> OtherKeysReleased;
+
+        core::math::Vector2 MousePosition;
+        std::array<InputTouchState, MaxTouches> Touches{};
+    };
+}
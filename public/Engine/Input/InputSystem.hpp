@@ -2,55 +2,259 @@
 
 #include <string>
 #include <string_view>
+#include <array>
 #include <vector>
-#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <Engine/Core/Hashing/FNV.hpp>
+#include <Engine/Core/Runtime/IMutex.hpp>
 
 #include <Engine/Input/InputEvent.hpp>
+#include <Engine/Input/InputListener.hpp>
+#include <Engine/Input/InputBindingTable.hpp>
+#include <Engine/Input/InputHistory.hpp>
+#include <Engine/Input/InputStateSnapshot.hpp>
 
 namespace engine::input {
-    using InputMapHandle = uint32_t;
+    struct InputManager;
 
-    struct AxisInputBinding {
-        InputMapHandle Mapping;
-        double Scale;
+    namespace literals {
+        // compile-time map handles, e.g. InputSystem::Instance()->GetAxisId("MoveForward"_axis)
+        constexpr InputMapHandle operator ""_axis(const char *name, size_t length) {
+            return FNVConstHash(std::string_view(name, length));
+        }
 
-        AxisInputBinding() : Mapping(0), Scale(0) {}
-        AxisInputBinding(InputMapHandle mapping, double scale) : Mapping(mapping), Scale(scale) {}
-        AxisInputBinding(const AxisInputBinding &other) : Mapping(other.Mapping), Scale(other.Scale) {}
-    };
+        constexpr InputMapHandle operator ""_button(const char *name, size_t length) {
+            return FNVConstHash(std::string_view(name, length));
+        }
+    }
 
+    // Maps keys and axes to named axis and button mappings. Every source may feed several mappings; axis mappings
+    // sum all of their sources and buttons are held while any of their sources is.
+    // An input system either sees the input of every player, like Instance(), or only the input of one player, with
+    // its own bindings and state; for local multiplayer use one system per seat rather than both kinds, since the
+    // global one would consume the seats' bound input first.
     struct InputSystem {
-        InputSystem() = default;
+        static constexpr uint8_t MaxLocalPlayers = 8;
+
+        explicit InputSystem(int32_t player = INPUT_LISTENER_PLAYER_ALL);
+
+        // listens to the given manager instead of the global one, e.g. to build an independent input context
+        explicit InputSystem(InputManager *manager, int32_t player = INPUT_LISTENER_PLAYER_ALL);
 
-        virtual ~InputSystem() = default;
+        virtual ~InputSystem();
 
         void Init();
 
         void Shutdown();
 
+        // publishes the state accumulated since the last call as a new snapshot
         void Update();
 
-        double GetAxis(std::string_view mapName);
+        // State as of the last Update. Wait-free and safe from any thread; see InputStateSnapshot for how long the
+        // reference stays valid. The getters below read the live state instead and belong to the dispatching thread.
+        const InputStateSnapshot &GetSnapshot() const {
+            return *m_CurrentSnapshot.load(std::memory_order_acquire);
+        }
+
+        // resolves against the latest bindings, including ones that haven't been adopted by the dispatch yet
+        InputAxisId GetAxisId(InputMapHandle mapHandle) const;
+
+        // ids of freshly published bindings read as zero until the dispatch adopts them
+        double GetAxis(InputAxisId axis) const {
+            return axis.Index < m_AxisValues.size() ? m_AxisValues[axis.Index] : 0.0;
+        }
+
+        double GetAxis(InputMapHandle mapHandle) const;
+
+        double GetAxis(std::string_view mapName) const;
 
         void BindAxis(std::string_view mapName, std::string_view axisOrKeyName, double scaleValue);
 
         void UnbindAxis(std::string_view mapName, std::string_view axisOrKeyName);
 
-        bool GetButton(std::string_view mapName);
+        void SetAxisSettings(std::string_view mapName, const InputAxisSettings &settings);
+
+        // replaces every binding, e.g. with the ones loaded through InputBindingConfig
+        void SetBindings(InputBindingSet bindings);
+
+        // copy of the bindings, to be edited and handed back through SetBindings
+        InputBindingSet GetBindings() const;
+
+        InputButtonId GetButtonId(InputMapHandle mapHandle) const;
+
+        bool GetButton(InputButtonId button) const {
+            return button.Index < m_ButtonPressCounts.size() &&
+                   ((m_ButtonBits[button.Index >> 6] >> (button.Index & 63)) & 1);
+        }
+
+        bool GetButton(InputMapHandle mapHandle) const;
+
+        bool GetButton(std::string_view mapName) const;
+
+        // edge queries compare the last two snapshots, so they hold for a whole frame, from any thread
+        bool GetButtonDown(InputButtonId button) const {
+            return GetSnapshot().GetButtonDown(button);
+        }
+
+        bool GetButtonDown(InputMapHandle mapHandle) const {
+            return GetSnapshot().GetButtonDown(mapHandle);
+        }
+
+        bool GetButtonDown(std::string_view mapName) const;
+
+        bool GetButtonUp(InputButtonId button) const {
+            return GetSnapshot().GetButtonUp(button);
+        }
+
+        bool GetButtonUp(InputMapHandle mapHandle) const {
+            return GetSnapshot().GetButtonUp(mapHandle);
+        }
+
+        bool GetButtonUp(std::string_view mapName) const;
+
+        // in nanoseconds, see InputStateSnapshot::GetButtonHeldFor
+        uint64_t GetButtonHeldFor(InputButtonId button) const {
+            return GetSnapshot().GetButtonHeldFor(button);
+        }
+
+        uint64_t GetButtonHeldFor(InputMapHandle mapHandle) const {
+            return GetSnapshot().GetButtonHeldFor(mapHandle);
+        }
+
+        uint64_t GetButtonHeldFor(std::string_view mapName) const;
+
+        // Timestamped changes of a mapping, for simulations running several fixed ticks per frame: a tick covering
+        // [t0, t1) reads GetValueAt(t0) and GetTransitions(t0, t1, ...) instead of the latest value, so presses
+        // shorter than a frame aren't lost. Buttons read 1.0 while held. Owned by the dispatching thread, like the
+        // live getters.
+        const InputHistory &GetAxisHistory(InputAxisId axis) const;
+
+        const InputHistory &GetAxisHistory(InputMapHandle mapHandle) const;
+
+        const InputHistory &GetButtonHistory(InputButtonId button) const;
+
+        const InputHistory &GetButtonHistory(InputMapHandle mapHandle) const;
 
         void BindButton(std::string_view mapName, std::string_view keyName);
 
         void UnbindButton(std::string_view mapName, std::string_view keyName);
 
+        // Declares a key sequence or chord triggering the combo mapping, in the config syntax: steps separated by
+        // spaces, keys of a chord by '+', e.g. BindCombo("Hadouken", "Key_ArrowDown Key_ArrowDown+Key_ArrowRight
+        // Key_ArrowRight+Key_A", 200). The window limits the time from the first step to the last, 0 for none.
+        void BindCombo(std::string_view mapName, std::string_view steps, uint32_t windowMilliseconds = 0);
+
+        // removes every sequence of the combo mapping
+        void UnbindCombo(std::string_view mapName);
+
+        InputComboId GetComboId(InputMapHandle mapHandle) const;
+
+        // completed since the previous Update; combos are matched on every key event, so they're never lost to a
+        // frame boundary
+        bool WasComboTriggered(InputComboId combo) const {
+            return GetSnapshot().WasComboTriggered(combo);
+        }
+
+        bool WasComboTriggered(InputMapHandle mapHandle) const {
+            return GetSnapshot().WasComboTriggered(mapHandle);
+        }
+
+        bool WasComboTriggered(std::string_view mapName) const;
+
+        // player id the system is scoped to, INPUT_LISTENER_PLAYER_ALL if it isn't
+        int32_t GetPlayer() const {
+            return m_Player;
+        }
+
         static InputSystem *Instance();
 
+        // input system of a local seat, created on first use; nullptr past MaxLocalPlayers. it has to be initialized
+        // and updated like the global one.
+        static InputSystem *PlayerInstance(uint8_t player);
+
     protected:
+        // axis sources at or above this magnitude hold the buttons they're bound to
+        static constexpr float ButtonPressThreshold = 0.5f;
+
         bool InternalInputCallback(const InputEvent &event);
 
-        std::unordered_map<InputAxisHandle, AxisInputBinding> m_AxisBindings;
-        std::unordered_map<InputKeyHandle, InputMapHandle> m_ButtonBindings;
+        // timestamp is the one of the event causing the change, 0 to leave the histories alone
+        void UpdateSource(uint32_t sourceIndex, float value, uint64_t timestamp);
+
+        // the histories record the new bindings' net effect at "timestamp", the time of the event being dispatched,
+        // so that they stay in the order the events are dispatched in
+        void AdoptBindingTable(std::shared_ptr<const InputBindingTable> table, uint64_t timestamp);
+
+        // picks up the table published last, if any; only called on the dispatching thread.
+        void AdoptPendingBindings(uint64_t timestamp);
+
+        // compiles m_BindingSet and publishes the result; mtx_Bindings must be held.
+        void PublishBindings();
+
+        void SetButtonState(InputButtonId button, bool state);
+
+        // raw key and pointer state, tracked for the snapshots whether or not anything is bound to them
+        void TrackKeyState(InputKeyHandle key, bool state);
+
+        void TrackPointer(const InputEvent &event);
+
+        bool IsKeyHeld(InputKeyHandle key) const;
+
+        // a snapshot is rewritten by every third Update, which gives readers a whole frame of slack
+        static constexpr size_t SnapshotBufferCount = 3;
+
+        // null until Init for systems listening to the global manager
+        InputManager *m_Manager;
+        int32_t m_Player;
+        InputListenerToken m_ListenerToken;
+
+        // Writers (BindAxis, SetBindings, ...) may run on any thread: they edit the binding set and compile a new
+        // table under mtx_Bindings, then hand it over through m_PendingTable with a single exchange. The dispatch
+        // only ever touches m_BindingTable and swaps the pending table in between two events, without locking.
+        std::unique_ptr<core::runtime::IMutex> mtx_Bindings;
+        InputBindingSet m_BindingSet;
+        // guarded by mtx_Bindings; ids are assigned against it, so they stay stable across publications.
+        std::shared_ptr<const InputBindingTable> m_PublishedTable;
+        std::atomic<std::shared_ptr<const InputBindingTable> *> m_PendingTable{nullptr};
+
+        // owned by the dispatching thread
+        std::shared_ptr<const InputBindingTable> m_BindingTable;
+
+        // current value of every source of the binding table, indexed like InputBindingTable::Sources
+        std::vector<float> m_SourceValues;
+
+        // indexed by axis id: sum of the contributions, number of sources contributing to it and the shaped value
+        // returned by GetAxis. slot 0 is the always-zero slot of unknown mappings.
+        std::vector<double> m_AxisSums;
+        std::vector<uint32_t> m_AxisActiveSources;
+        std::vector<double> m_AxisValues{0.0};
+
+        // indexed by button id: number of sources holding the button, and the resulting state bits
+        std::vector<uint32_t> m_ButtonPressCounts;
+        std::vector<uint64_t> m_ButtonBits{0};
+
+        // indexed by axis and button id; kept across binding tables
+        std::vector<InputHistory> m_AxisHistories;
+        std::vector<InputHistory> m_ButtonHistories;
+
+        // owned by the dispatching thread, copied into the snapshots by Update
+        std::array<uint64_t, 4> m_BuiltinKeyBits{};
+        std::vector<InputKeyHandle> m_OtherKeysDown;
+        core::math::Vector2 m_MousePosition;
+        std::array<InputTouchState, InputStateSnapshot::MaxTouches> m_Touches{};
+
+        // progress through the combo automaton of m_BindingTable, and the combos completed since the last Update,
+        // indexed by combo id
+        InputComboMatcher::State m_ComboState;
+        std::vector<uint32_t> m_MatchedCombos;
+        std::vector<uint64_t> m_ComboTriggeredBits{0};
 
-        std::unordered_map<InputMapHandle, double> m_AxisState;
-        std::unordered_map<InputMapHandle, bool> m_ButtonState;
+        std::array<InputStateSnapshot, SnapshotBufferCount> m_Snapshots;
+        std::atomic<const InputStateSnapshot *> m_CurrentSnapshot{&m_Snapshots[0]};
+        uint64_t m_Frame{0};
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <iterator>
+#include <string_view>
+
+#include <Engine/Input/InputClock.hpp>
+
+// Highest trace level compiled in; writes above it vanish at compile time. Set through the RIFT_INPUT_TRACE_LEVEL
+// CMake cache variable.
+#ifndef RIFT_INPUT_TRACE_LEVEL
+#define RIFT_INPUT_TRACE_LEVEL 3
+#endif
+
+namespace engine::input {
+    enum InputTraceLevel : uint8_t {
+        INPUT_TRACE_LEVEL_OFF,
+        INPUT_TRACE_LEVEL_ERROR,
+        INPUT_TRACE_LEVEL_WARNING,
+        INPUT_TRACE_LEVEL_INFO,
+        INPUT_TRACE_LEVEL_DEBUG,
+        INPUT_TRACE_LEVEL_VERBOSE
+    };
+
+    enum InputTraceEvent : uint16_t {
+        INPUT_TRACE_EVENT_KEY_PUSHED,
+        INPUT_TRACE_EVENT_KEY_REJECTED,
+        INPUT_TRACE_EVENT_AXIS_PUSHED,
+        INPUT_TRACE_EVENT_CHAR_PUSHED,
+        INPUT_TRACE_EVENT_POINTER_PUSHED,
+        INPUT_TRACE_EVENT_EVENTS_DROPPED,
+        INPUT_TRACE_EVENT_EVENT_FILTERED,
+        INPUT_TRACE_EVENT_EVENT_CONSUMED,
+        INPUT_TRACE_EVENT_SOURCE_UPDATED,
+        INPUT_TRACE_EVENT_BINDINGS_ADOPTED,
+
+        INPUT_TRACE_EVENT_COUNT
+    };
+
+    // how the decoder prints an argument
+    enum InputTraceArgKind : uint8_t {
+        INPUT_TRACE_ARG_NONE,
+        INPUT_TRACE_ARG_UINT,
+        INPUT_TRACE_ARG_HEX,
+        INPUT_TRACE_ARG_FLOAT,
+        INPUT_TRACE_ARG_EVENT_TYPE,
+        // two floats, x in the low and y in the high half
+        INPUT_TRACE_ARG_POSITION
+    };
+
+    struct InputTraceEventInfo {
+        std::string_view Name;
+        std::string_view Arg0Name;
+        InputTraceArgKind Arg0Kind;
+        std::string_view Arg1Name;
+        InputTraceArgKind Arg1Kind;
+    };
+
+    // only read by the decoder; indexed by InputTraceEvent
+    inline constexpr InputTraceEventInfo g_InputTraceEventInfo[] = {
+            {"KeyPushed",       "key",     INPUT_TRACE_ARG_HEX,        "state",    INPUT_TRACE_ARG_UINT},
+            {"KeyRejected",     "key",     INPUT_TRACE_ARG_HEX,        {},         INPUT_TRACE_ARG_NONE},
+            {"AxisPushed",      "axis",    INPUT_TRACE_ARG_HEX,        "value",    INPUT_TRACE_ARG_FLOAT},
+            {"CharPushed",      "char",    INPUT_TRACE_ARG_UINT,       {},         INPUT_TRACE_ARG_NONE},
+            {"PointerPushed",   "type",    INPUT_TRACE_ARG_EVENT_TYPE, "position", INPUT_TRACE_ARG_POSITION},
+            {"EventsDropped",   {},        INPUT_TRACE_ARG_NONE,       "count",    INPUT_TRACE_ARG_UINT},
+            {"EventFiltered",   "type",    INPUT_TRACE_ARG_EVENT_TYPE, {},         INPUT_TRACE_ARG_NONE},
+            {"EventConsumed",   "type",    INPUT_TRACE_ARG_EVENT_TYPE, "listener", INPUT_TRACE_ARG_UINT},
+            {"SourceUpdated",   "source",  INPUT_TRACE_ARG_HEX,        "value",    INPUT_TRACE_ARG_FLOAT},
+            {"BindingsAdopted", "sources", INPUT_TRACE_ARG_UINT,       "bindings", INPUT_TRACE_ARG_UINT},
+    };
+
+    static_assert(std::size(g_InputTraceEventInfo) == INPUT_TRACE_EVENT_COUNT, "every trace event needs its info");
+
+    struct InputTraceRecord {
+        uint64_t Timestamp;
+        InputTraceEvent Event;
+        InputTraceLevel Level;
+        uint8_t Reserved;
+        uint32_t Arg0;
+        uint64_t Arg1;
+    };
+
+    static_assert(sizeof(InputTraceRecord) == 24, "InputTraceRecord layout has changed");
+
+    // Flight recorder for the input hot paths. Every thread writes fixed-size binary records into its own ring, so a
+    // write is a handful of stores with no formatting, locking or I/O. Writes above RIFT_INPUT_TRACE_LEVEL compile to
+    // nothing. The rings are written to a file through Dump and turned into text offline through Decode.
+    struct InputTrace {
+        static constexpr uint32_t FileMagic = 0x52544952; // "RITR"
+        static constexpr uint32_t FileVersion = 1;
+
+        // records per thread; older records are overwritten
+        static constexpr uint32_t RingCapacity = 2048;
+
+        template<InputTraceLevel Level>
+        static void Write(InputTraceEvent event, uint32_t arg0 = 0, uint64_t arg1 = 0) {
+            if constexpr (Level != INPUT_TRACE_LEVEL_OFF && Level <= RIFT_INPUT_TRACE_LEVEL) {
+                Append({InputClock::Now(), event, Level, 0, arg0, arg1});
+            }
+        }
+
+        static uint32_t FloatArg(float value) {
+            return std::bit_cast<uint32_t>(value);
+        }
+
+        static uint64_t PositionArg(float x, float y) {
+            return static_cast<uint64_t>(std::bit_cast<uint32_t>(y)) << 32 | std::bit_cast<uint32_t>(x);
+        }
+
+        // writes the rings of every thread that traced so far, oldest records first. records being written while
+        // dumping may come out torn, so this is best done once input is idle, e.g. on shutdown.
+        static bool Dump(const std::filesystem::path &path);
+
+        // prints a dump as text, one record per line
+        static bool Decode(const std::filesystem::path &path, std::FILE *out);
+
+    protected:
+        static void Append(const InputTraceRecord &record);
+    };
+}
@@ -0,0 +1,111 @@
+#include <Engine/Input/InputComboMatcher.hpp>
+
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+// Checks of the combo matcher's chord and sequence handling. Exits with the number of failed checks:
+//   Rift_Input_tests
+
+using namespace engine::input;
+
+static int g_Failures = 0;
+
+#define CHECK(condition)                                                                       \
+    do {                                                                                       \
+        if (!(condition)) {                                                                    \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++g_Failures;                                                                      \
+        }                                                                                      \
+    } while (false)
+
+static constexpr InputKeyHandle KeyA = 1;
+static constexpr InputKeyHandle KeyB = 2;
+static constexpr InputKeyHandle KeyC = 3;
+static constexpr InputKeyHandle KeyD = 4;
+static constexpr InputKeyHandle KeyDown = 10;
+static constexpr InputKeyHandle KeyRight = 11;
+
+// key presses (true) and releases (false), one millisecond apart
+using KeyScript = std::vector<std::pair<InputKeyHandle, bool>>;
+
+static std::vector<uint32_t> Run(const InputComboMatcher &matcher, const KeyScript &script) {
+    InputComboMatcher::State state;
+    std::vector<uint32_t> matched;
+    uint64_t timestamp = 0;
+
+    matcher.Reset(state);
+
+    for (auto [key, pressed]: script) {
+        matcher.Advance(state, key, pressed, timestamp, matched);
+        timestamp += 1000000;
+    }
+
+    return matched;
+}
+
+static void TestChordOrder() {
+    auto matcher = InputComboMatcher::Compile({{1, {{KeyB, KeyC}}, 0}});
+
+    CHECK(Run(matcher, {{KeyB, true}, {KeyC, true}}) == std::vector<uint32_t>{1});
+    CHECK(Run(matcher, {{KeyC, true}, {KeyB, true}}) == std::vector<uint32_t>{1});
+    // let go of before it completed
+    CHECK(Run(matcher, {{KeyB, true}, {KeyB, false}, {KeyC, true}}).empty());
+}
+
+static void TestSequenceThenChord() {
+    auto matcher = InputComboMatcher::Compile({{1, {{KeyA}, {KeyB, KeyC}}, 0}});
+
+    CHECK(Run(matcher, {{KeyA, true}, {KeyA, false}, {KeyB, true}, {KeyC, true}}) == std::vector<uint32_t>{1});
+    CHECK(Run(matcher, {{KeyA, true}, {KeyA, false}, {KeyC, true}, {KeyB, true}}) == std::vector<uint32_t>{1});
+    // the chord may be pressed while the previous step is still held
+    CHECK(Run(matcher, {{KeyA, true}, {KeyB, true}, {KeyC, true}}) == std::vector<uint32_t>{1});
+    // a repeated first step doesn't
+    CHECK(Run(matcher, {{KeyA, true}, {KeyA, false}, {KeyA, true}, {KeyA, false}, {KeyB, true}, {KeyC, true}}) ==
+          std::vector<uint32_t>{1});
+    // an abandoned chord breaks the sequence
+    CHECK(Run(matcher, {{KeyA, true}, {KeyA, false}, {KeyB, true}, {KeyB, false}, {KeyB, true}, {KeyC, true}})
+                  .empty());
+}
+
+static void TestChordBreaksOnForeignKey() {
+    auto matcher = InputComboMatcher::Compile({{1, {{KeyA}, {KeyB, KeyC}}, 0}, {2, {{KeyD, KeyC}}, 0}});
+
+    // B and D make up no single step
+    CHECK(Run(matcher, {{KeyA, true}, {KeyA, false}, {KeyB, true}, {KeyD, true}, {KeyC, true}}) ==
+          std::vector<uint32_t>{2});
+}
+
+static void TestChordSequenceWithinWindow() {
+    // Down, Down+Right, Right+A within 200 ms
+    auto matcher = InputComboMatcher::Compile(
+            {{1, {{KeyDown}, {KeyDown, KeyRight}, {KeyRight, KeyA}}, 200000000}});
+
+    CHECK(Run(matcher, {{KeyDown, true}, {KeyRight, true}, {KeyDown, false}, {KeyA, true}}) ==
+          std::vector<uint32_t>{1});
+    // Right goes down before Down in the chord
+    CHECK(Run(matcher, {{KeyDown, true}, {KeyDown, false}, {KeyRight, true}, {KeyDown, true}, {KeyDown, false},
+                        {KeyA, true}}) == std::vector<uint32_t>{1});
+
+    InputComboMatcher::State state;
+    std::vector<uint32_t> matched;
+
+    matcher.Reset(state);
+    matcher.Advance(state, KeyDown, true, 0, matched);
+    matcher.Advance(state, KeyRight, true, 100000000, matched);
+    matcher.Advance(state, KeyA, true, 300000000, matched);
+    CHECK(matched.empty());
+}
+
+int main() {
+    TestChordOrder();
+    TestSequenceThenChord();
+    TestChordBreaksOnForeignKey();
+    TestChordSequenceWithinWindow();
+
+    if (g_Failures == 0) {
+        std::printf("all checks passed\n");
+    }
+
+    return g_Failures;
+}
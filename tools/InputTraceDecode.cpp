@@ -0,0 +1,19 @@
+#include <Engine/Input/InputTrace.hpp>
+
+#include <cstdio>
+
+// prints a dump written by InputTrace::Dump as text:
+//   Rift_Input_TraceDecode <trace file>
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <trace file>\n", argv[0]);
+        return 1;
+    }
+
+    if (!engine::input::InputTrace::Decode(argv[1], stdout)) {
+        std::fprintf(stderr, "'%s' is not a valid input trace.\n", argv[1]);
+        return 1;
+    }
+
+    return 0;
+}